@@ -15,11 +15,61 @@
 #include <iostream>
 #include <fstream>
 #include <string>
+#include <string_view>
+#include <cstring>
 #include <sstream>
 #include <limits>
 #include <algorithm>
 #include <vector>
 #include <memory>
+#include <memory_resource>
+#include <new>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <shared_mutex>
+#include <cstdint>
+#include <stdexcept>
+#include <unordered_set>
+#include <future>
+#include <array>
+#include <condition_variable>
+#include <cerrno>
+#include <deque>
+#include <optional>
+#include <unordered_map>
+#include <filesystem>
+
+#ifdef _WIN32
+#define NOMINMAX
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+// SIMD paths for the CSV tokenizer and the prerequisite closure bitsets
+#if defined(__AVX2__)
+#define ABCU_USE_AVX2
+#include <immintrin.h>
+#endif
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define ABCU_USE_SSE2
+#include <emmintrin.h>
+#endif
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+// Transparent gzip input for the streaming loader (build with -DABCU_WITH_ZLIB -lz)
+#ifdef ABCU_WITH_ZLIB
+#include <zlib.h>
+#endif
 
 using namespace std;
 
@@ -33,540 +83,8176 @@ using namespace std;
  * Each course includes a unique ID, course name, and list of prerequesite 
  * course IDs.
  * 
+ * The strings are allocator-aware so that a tree can place a course's text 
+ * in the same arena as its node. Courses built outside a tree use the 
+ * default heap.
+ * 
  */
 struct Course {
-    string courseId;                /// Unique Course Identifier
-    string name;                    /// Full Course Name
-    vector<string> prerequisites;   /// List of Course ID's that are prerequisites
+    using allocator_type = pmr::polymorphic_allocator<char>;
+
+    pmr::string courseId;                   /// Unique Course Identifier
+    pmr::string name;                       /// Full Course Name
+    pmr::vector<pmr::string> prerequisites; /// List of Course ID's that are prerequisites
+
+    // Constructors
+    Course() = default;
+    Course(const Course& other) = default;
+    Course(Course&& other) = default;
+    Course& operator=(const Course& other) = default;
+    Course& operator=(Course&& other) = default;
+
+    // Allocator-Extended Constructors
+    explicit Course(const allocator_type& alloc) :
+        courseId(alloc),
+        name(alloc),
+        prerequisites(alloc) {}
+
+    Course(const Course& other, const allocator_type& alloc) :
+        courseId(other.courseId, alloc),
+        name(other.name, alloc),
+        prerequisites(other.prerequisites, alloc) {}
+
+    Course(Course&& other, const allocator_type& alloc) :
+        courseId(move(other.courseId), alloc),
+        name(move(other.name), alloc),
+        prerequisites(move(other.prerequisites), alloc) {}
+};
+
+/**
+ * @brief Fixed-width packed form of a course ID.
+ *
+ * The first 16 characters are stored most significant first and shorter 
+ * IDs are padded with zeros, so comparing the integers orders IDs the same 
+ * way as comparing the strings. Typical IDs such as "CSCI400" differ in the 
+ * first integer alone. IDs longer than 16 characters that share a prefix 
+ * pack equal; compareCourseKeys() and matchesCourseKey() fall back to the 
+ * strings for those.
+ */
+struct CourseKey {
+    static constexpr size_t PACKED_CHARS = 16;
+
+    uint64_t high;      /// Characters 0-7
+    uint64_t low;       /// Characters 8-15
+
+    static CourseKey Pack(string_view courseId);
 };
 
+/**
+ * @brief Packs a course ID into a CourseKey.
+ *
+ * @param courseId The course ID to pack.
+ * @return The packed key.
+ */
+CourseKey CourseKey::Pack(string_view courseId) {
+    unsigned char bytes[PACKED_CHARS] = {};
+    memcpy(bytes, courseId.data(), min(courseId.size(), PACKED_CHARS));
+
+    CourseKey key = { 0, 0 };
+    for (size_t i = 0; i < 8; ++i) {
+        key.high = (key.high << 8) | bytes[i];
+        key.low = (key.low << 8) | bytes[i + 8];
+    }
+    return key;
+}
+
+/**
+ * @brief Orders a stored course against a search key.
+ *
+ * Comparisons are integer compares; the stored course is only read when 
+ * the packed keys tie on an ID of 16 or more characters.
+ *
+ * @param stored Packed key of the stored course.
+ * @param storedCourse The stored course.
+ * @param key Packed search key.
+ * @param courseId The course ID being searched for.
+ * @return Negative, zero, or positive as the stored course sorts before, 
+ *         equal to, or after the search key.
+ */
+inline int compareCourseKeys(const CourseKey& stored, const Course& storedCourse,
+                             const CourseKey& key, string_view courseId) {
+    if (stored.high != key.high) {
+        return stored.high < key.high ? -1 : 1;
+    }
+    if (stored.low != key.low) {
+        return stored.low < key.low ? -1 : 1;
+    }
+    if (courseId.size() < CourseKey::PACKED_CHARS) {
+        return 0;
+    }
+    return string_view(storedCourse.courseId).compare(courseId);
+}
+
+/**
+ * @brief Checks whether a stored course has the searched-for ID.
+ *
+ * @param stored Packed key of the stored course.
+ * @param storedCourse The stored course.
+ * @param key Packed search key.
+ * @param courseId The course ID being searched for.
+ * @return True if the IDs are equal.
+ */
+inline bool matchesCourseKey(const CourseKey& stored, const Course& storedCourse,
+                             const CourseKey& key, string_view courseId) {
+    return stored.high == key.high && stored.low == key.low &&
+           (courseId.size() < CourseKey::PACKED_CHARS || storedCourse.courseId == courseId);
+}
+
+/**
+ * @brief Hashes a packed course ID.
+ *
+ * Mixes both halves of the key with multiply-xorshift rounds so that IDs 
+ * differing only in their last characters still spread across all bits.
+ *
+ * @param key The packed course ID.
+ * @return The hash value.
+ */
+inline uint64_t hashCourseKey(const CourseKey& key) {
+    uint64_t hash = key.high ^ (key.low * 0x9E3779B97F4A7C15ULL);
+    hash ^= hash >> 32;
+    hash *= 0xD6E8FEB86659FD93ULL;
+    hash ^= hash >> 32;
+    return hash;
+}
+
+/// Tree builds and set operations on fewer nodes than this run on the calling thread.
+constexpr size_t PARALLEL_TREE_GRAIN = 1 << 12;
+
+/// Inputs smaller than this are sorted on the calling thread.
+constexpr size_t PARALLEL_SORT_THRESHOLD = 1 << 16;
+
+/// CSV files are read and parsed in chunks of at least this many bytes, one per thread.
+constexpr size_t PARALLEL_LOAD_GRAIN = 1 << 22;
+
+/**
+ * @brief Sorts a vector, splitting the work across threads when it is large.
+ *
+ * The vector is cut into one run per thread, the runs are sorted 
+ * concurrently, and then adjacent runs are merged pairwise (also in 
+ * parallel) until one sorted run remains.
+ *
+ * @param items The vector to sort.
+ * @param less Strict weak ordering for the elements.
+ * @param threads Most threads to use.
+ */
+template <typename T, typename Compare>
+void parallelSort(vector<T>& items, Compare less, unsigned threads) {
+    size_t runs = min<size_t>(max(1u, threads), items.size() / (PARALLEL_SORT_THRESHOLD / 2));
+
+    if (items.size() < PARALLEL_SORT_THRESHOLD || runs < 2) {
+        sort(items.begin(), items.end(), less);
+        return;
+    }
+
+    // Boundaries of each run; run i is [bounds[i], bounds[i + 1])
+    vector<size_t> bounds;
+    for (size_t i = 0; i <= runs; ++i) {
+        bounds.push_back(items.size() * i / runs);
+    }
+
+    vector<thread> workers;
+    for (size_t i = 0; i < runs; ++i) {
+        workers.emplace_back([&items, &bounds, &less, i]() {
+            sort(items.begin() + bounds[i], items.begin() + bounds[i + 1], less);
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    // Merge neighbouring runs, doubling the run width each round
+    for (size_t width = 1; width < runs; width *= 2) {
+        workers.clear();
+        for (size_t i = 0; i + width < runs; i += 2 * width) {
+            size_t first = bounds[i];
+            size_t middle = bounds[i + width];
+            size_t last = bounds[min(i + 2 * width, runs)];
+            workers.emplace_back([&items, &less, first, middle, last]() {
+                inplace_merge(items.begin() + first, items.begin() + middle, items.begin() + last, less);
+            });
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+    }
+}
+
 /**
  * @brief Node structure to hold course information for the Binary Search Tree.
  *
- * Each node stores a Course, the node's height (for AVL balancing), and 
- * pointers to it's child nodes. 
+ * Each node stores a Course, its packed key, the node's height (for AVL 
+ * balancing), the size of its subtree (for rank and select), and pointers 
+ * to it's child nodes. Nodes are owned by the tree's arena rather 
+ * than by their parent, so the child pointers are non-owning.
  *
  */
 struct Node {
+    CourseKey key;      /// Packed course ID, compared instead of the string
     Course course;
-    unique_ptr<Node> left;
-    unique_ptr<Node> right;
+    Node* left;
+    Node* right;
     int height;
+    size_t size;        /// Number of nodes in this subtree, including this one
 
     // Custom Constructor
-    Node(Course iCourse) :
-        course(move(iCourse)),
+    Node(Course iCourse, const Course::allocator_type& alloc) :
+        key(CourseKey::Pack(iCourse.courseId)),
+        course(move(iCourse), alloc),
         left(nullptr),
         right(nullptr),
-        height(0) {}
+        height(0),
+        size(1) {}
 };
 
 //============================================================================
-// Binary Search Tree Class Definition
+// B-Tree Backend
 //============================================================================
 
 /**
- * @class BinarySearchTree
- * @brief AVL-based binary search tree that stores and manages course data.
+ * @class CourseBTree
+ * @brief Cache-friendly B-tree that stores course data.
  *
- * Supports node insertion, search, traversal, deletion, and self-balancing.
+ * Each node keeps its packed keys in one contiguous array sized to fill two 
+ * cache lines, so a lookup touches about log_8(n) nodes instead of the 
+ * log_2(n) nodes of a binary tree. Courses are stored out of line and 
+ * moved between nodes by pointer. Used by BinarySearchTree when it is 
+ * constructed with TreeBackend::BTree, which always provides an arena, so 
+ * the tree is released by the arena rather than node by node.
  */
-class BinarySearchTree {
+class CourseBTree {
+
+    public:
+        static constexpr int MIN_DEGREE = 4;                 /// Minimum children of a non-root internal node
+        static constexpr int MAX_KEYS = 2 * MIN_DEGREE - 1;  /// 7 packed keys = 112 bytes per node
 
     private:
-        unique_ptr<Node> root;
-
-        // AVL Support & Recursive Helper Methods
-        int height(const unique_ptr<Node>& node);
-        void updateHeight(unique_ptr<Node>& node);
-        unique_ptr<Node> leftRotate(unique_ptr<Node> node);
-        unique_ptr<Node> rightRotate(unique_ptr<Node> node);
-        unique_ptr<Node> rebalance(unique_ptr<Node> node);
-        unique_ptr<Node> addNode(unique_ptr<Node> node, Course course);
-        unique_ptr<Node> removeNode(unique_ptr<Node> node, const string& courseId);
-        Node* searchNode(Node* node, const string& courseId);
-
-        // Recursive Traversal Methods
-        void inOrder(const unique_ptr<Node>& node);
-        void postOrder(const unique_ptr<Node>& node);
-        void preOrder(const unique_ptr<Node>& node);
+        struct BNode {
+            CourseKey keys[MAX_KEYS];           /// Packed keys, searched linearly
+            Course* courses[MAX_KEYS];          /// Courses, parallel to keys
+            BNode* children[MAX_KEYS + 1];      /// Child nodes (unused in leaves)
+            int count;                          /// Number of keys in use
+            bool leaf;
+        };
 
-    public:
-        // Default Constructor
-        BinarySearchTree();
+        BNode* root;
+        pmr::memory_resource* resource;         /// Source of node and course memory
 
-        // Traversal Methods
-        void InOrder();
-        void PostOrder();
-        void PreOrder();
+        // Storage Methods
+        BNode* createNode(bool leaf);
+        Course* createCourse(Course course);
+        void destroyCourse(Course* course);
 
-        // Core Tree Operation Methods
-        void Insert(Course course);
-        void Remove(const string& courseId);
-        Course Search(string courseId);
+        // Helper Methods
+        static int findPosition(const BNode* node, const CourseKey& key, string_view courseId);
+        static bool matches(const BNode* node, int index, const CourseKey& key, string_view courseId);
+        void splitChild(BNode* parent, int index);
+        void insertNonFull(BNode* node, const CourseKey& key, Course* course);
+        void mergeChildren(BNode* node, int index);
+        void fillChild(BNode* node, int index);
+        Course* removeFrom(BNode* node, const CourseKey& key, string_view courseId);
+        template <typename Visitor>
+        static void visitInOrder(const BNode* node, Visitor& visit);
+        template <typename Visitor>
+        static bool visitFrom(const BNode* node, const CourseKey& key, string_view courseId, Visitor& visit);
 
-        /**
-         * @class DuplicateCourseException
-         * @brief Exception thrown when attempting to insert a course with a duplicate ID.
-         */
-        class DuplicateCourseException : public exception {
-            string message;
-        public:
-            explicit DuplicateCourseException(const string& courseId) {
-                message = "Duplicate course ID \"" + courseId + "\" was ignored.";
-            }
-            const char* what() const noexcept override {
-                return message.c_str();
-            }
-        };
+    public:
+        explicit CourseBTree(pmr::memory_resource* memory);
+
+        const Course* Insert(Course course);
+        bool Remove(string_view courseId);
+        const Course* Search(string_view courseId) const;
+        template <typename Visitor>
+        void VisitInOrder(Visitor&& visit) const;
+        template <typename Visitor>
+        void VisitFrom(string_view courseId, Visitor&& visit) const;
+        void Abandon();
 };
 
 /**
- * @brief Default constructor for BinarySearchTree.
+ * @brief Constructs an empty B-tree.
+ *
+ * @param memory Memory resource for nodes and courses.
  */
-BinarySearchTree::BinarySearchTree() {
+CourseBTree::CourseBTree(pmr::memory_resource* memory) {
     root = nullptr;
+    resource = memory;
 }
 
-//============================================================================
-// Private Class Methods
-//============================================================================
-
 /**
- * @brief Returns the height of a node in the tree.
- *
- * Used for AVL balancing. If the node is null, returns -1.
+ * @brief Allocates an empty node.
  *
- * @param node Unique pointer to the node.
- * @return Height of the node, or -1 if null.
+ * @param leaf True if the node has no children.
+ * @return Pointer to the new node.
  */
-int BinarySearchTree::height(const unique_ptr<Node>& node) {
-    return node ? node->height : -1;
+CourseBTree::BNode* CourseBTree::createNode(bool leaf) {
+    BNode* node = new (resource->allocate(sizeof(BNode), alignof(BNode))) BNode();
+    node->count = 0;
+    node->leaf = leaf;
+    return node;
 }
 
 /**
- * @brief Updates the height of a node based on its children.
+ * @brief Copies a course into the tree's memory resource.
  *
- * Called after modifications to the subtree (e.g., insert, remove).
- *
- * @param node Unique pointer to the node.
+ * @param course The course to store.
+ * @return Pointer to the stored course.
  */
-void BinarySearchTree::updateHeight(unique_ptr<Node>& node) {
-    if (node) {
-        node->height = max(height(node->left), height(node->right)) + 1;
-    }
+Course* CourseBTree::createCourse(Course course) {
+    void* slot = resource->allocate(sizeof(Course), alignof(Course));
+    return new (slot) Course(move(course), Course::allocator_type(resource));
 }
 
 /**
- * @brief Performs in-order traversal of the tree.
+ * @brief Destroys a course that has been removed from the tree.
  *
- * Visits nodes in ascending order of course ID.
- *
- * @param node Pointer to the current node (recursive).
+ * @param course The course to destroy.
  */
-void BinarySearchTree::inOrder(const unique_ptr<Node>& node) {
-    if (node) {
-        inOrder(node->left);
-        cout << node->course.courseId << ", " << node->course.name << endl;
-        inOrder(node->right);
-    }
+void CourseBTree::destroyCourse(Course* course) {
+    course->~Course();
+    resource->deallocate(course, sizeof(Course), alignof(Course));
 }
 
 /**
- * @brief Performs post-order traversal of the tree.
- *
- * Visits left and right children before processing the node.
+ * @brief Finds the first key in a node that is not less than the search key.
  *
- * @param node Pointer to the current node (recursive).
+ * @param node The node to scan.
+ * @param key Packed search key.
+ * @param courseId The course ID being searched for (breaks ties).
+ * @return Index of the first key >= the search key, or node->count.
  */
-void BinarySearchTree::postOrder(const unique_ptr<Node>& node) {
-    if (node) {
-        postOrder(node->left);
-        postOrder(node->right);
-        cout << node->course.courseId << ", " << node->course.name << endl;
+int CourseBTree::findPosition(const BNode* node, const CourseKey& key, string_view courseId) {
+    int index = 0;
+    while (index < node->count &&
+           compareCourseKeys(node->keys[index], *node->courses[index], key, courseId) < 0) {
+        ++index;
     }
+    return index;
 }
 
 /**
- * @brief Performs pre-order traversal of the tree.
- *
- * Visits node before processing its left and right children.
+ * @brief Checks whether the key at an index equals the search key.
  *
- * @param node Pointer to the current node (recursive).
+ * @param node The node to check.
+ * @param index Position returned by findPosition().
+ * @param key Packed search key.
+ * @param courseId The course ID being searched for.
+ * @return True if the key at index matches.
  */
-void BinarySearchTree::preOrder(const unique_ptr<Node>& node) {
-    if (node) {
-        cout << node->course.courseId << ", " << node->course.name << endl;
-        preOrder(node->left);
-        preOrder(node->right);
-    }
+bool CourseBTree::matches(const BNode* node, int index, const CourseKey& key, string_view courseId) {
+    return index < node->count &&
+           matchesCourseKey(node->keys[index], *node->courses[index], key, courseId);
 }
 
 /**
- * @brief Performs a left rotation on the subtree rooted at node.
- *
- * Used for rebalancing AVL trees when right-heavy.
+ * @brief Splits a full child in two, moving its median key into the parent.
  *
- * @param node Root of the unbalanced subtree.
- * @return New root after rotation.
+ * @param parent A node with room for one more key.
+ * @param index Index of the full child.
  */
-unique_ptr<Node> BinarySearchTree::leftRotate(unique_ptr<Node> node) {
-    unique_ptr<Node> rightChild = move(node->right);
-    node->right = move(rightChild->left);
-    rightChild->left = move(node);
+void CourseBTree::splitChild(BNode* parent, int index) {
+    BNode* child = parent->children[index];
+    BNode* sibling = createNode(child->leaf);
 
-    updateHeight(rightChild->left);
-    updateHeight(rightChild);
+    // Upper half of the child moves to the new sibling
+    sibling->count = MIN_DEGREE - 1;
+    for (int i = 0; i < MIN_DEGREE - 1; ++i) {
+        sibling->keys[i] = child->keys[i + MIN_DEGREE];
+        sibling->courses[i] = child->courses[i + MIN_DEGREE];
+    }
+    if (!child->leaf) {
+        for (int i = 0; i < MIN_DEGREE; ++i) {
+            sibling->children[i] = child->children[i + MIN_DEGREE];
+        }
+    }
+    child->count = MIN_DEGREE - 1;
 
-    return rightChild;
+    // Make room in the parent for the median key and the new sibling
+    for (int i = parent->count; i > index; --i) {
+        parent->children[i + 1] = parent->children[i];
+    }
+    parent->children[index + 1] = sibling;
+    for (int i = parent->count - 1; i >= index; --i) {
+        parent->keys[i + 1] = parent->keys[i];
+        parent->courses[i + 1] = parent->courses[i];
+    }
+    parent->keys[index] = child->keys[MIN_DEGREE - 1];
+    parent->courses[index] = child->courses[MIN_DEGREE - 1];
+    ++parent->count;
 }
 
 /**
- * @brief Performs a right rotation on the subtree rooted at node.
+ * @brief Inserts a key into a subtree whose root is not full.
  *
- * Used for rebalancing AVL trees when left-heavy.
+ * Full children are split on the way down, so the insert never has to 
+ * walk back up the tree.
  *
- * @param node Root of the unbalanced subtree.
- * @return New root after rotation.
+ * @param node Root of the subtree (recursive).
+ * @param key Packed key of the course.
+ * @param course The stored course.
  */
-unique_ptr<Node> BinarySearchTree::rightRotate(unique_ptr<Node> node) {
-    unique_ptr<Node> leftChild = move(node->left);
-    node->left = move(leftChild->right);
-    leftChild->right = move(node);
+void CourseBTree::insertNonFull(BNode* node, const CourseKey& key, Course* course) {
+    int index = findPosition(node, key, course->courseId);
 
-    updateHeight(leftChild->right);
-    updateHeight(leftChild);
+    if (node->leaf) {
+        for (int i = node->count; i > index; --i) {
+            node->keys[i] = node->keys[i - 1];
+            node->courses[i] = node->courses[i - 1];
+        }
+        node->keys[index] = key;
+        node->courses[index] = course;
+        ++node->count;
+        return;
+    }
 
-    return leftChild;
+    if (node->children[index]->count == MAX_KEYS) {
+        splitChild(node, index);
+        if (compareCourseKeys(node->keys[index], *node->courses[index], key, course->courseId) < 0) {
+            ++index;
+        }
+    }
+    insertNonFull(node->children[index], key, course);
 }
 
-
 /**
- * @brief Rebalances a node if it has become unbalanced.
+ * @brief Merges child index + 1 and the separating key into child index.
  *
- * Handles left-left, left-right, right-right, and right-left cases.
- *
- * @param node The subtree root to check and rebalance.
- * @return Root of the balanced subtree.
+ * @param node Parent of the two children.
+ * @param index Index of the left child.
  */
-unique_ptr<Node> BinarySearchTree::rebalance(unique_ptr<Node> node) {
-    if (!node) {
-        return node;
-    }
-
-    updateHeight(node);
-    int balance = height(node->left) - height(node->right);
+void CourseBTree::mergeChildren(BNode* node, int index) {
+    BNode* child = node->children[index];
+    BNode* sibling = node->children[index + 1];
 
-    // Left Heavy
-    if (balance > 1) {
-        // Left-Left
-        if (height(node->left->left) >= height(node->left->right)) {
-            return rightRotate(move(node));
-        }
-        // Left-Right
-        else {
-            node->left = leftRotate(move(node->left));
-            return rightRotate(move(node));
-        }
+    // Separator moves down, then the sibling's keys and children follow it
+    child->keys[child->count] = node->keys[index];
+    child->courses[child->count] = node->courses[index];
+    for (int i = 0; i < sibling->count; ++i) {
+        child->keys[child->count + 1 + i] = sibling->keys[i];
+        child->courses[child->count + 1 + i] = sibling->courses[i];
     }
-    // Right Heavy
-    else if (balance < -1) {
-        // Right-Right
-        if (height(node->right->right) >= height(node->right->left)) {
-            return leftRotate(move(node));
-        }
-        // Right-Left
-        else {
-            node->right = rightRotate(move(node->right));
-            return leftRotate(move(node));
+    if (!child->leaf) {
+        for (int i = 0; i <= sibling->count; ++i) {
+            child->children[child->count + 1 + i] = sibling->children[i];
         }
     }
+    child->count += sibling->count + 1;
 
-    return node;
-} 
+    // Close the gap in the parent
+    for (int i = index + 1; i < node->count; ++i) {
+        node->keys[i - 1] = node->keys[i];
+        node->courses[i - 1] = node->courses[i];
+    }
+    for (int i = index + 2; i <= node->count; ++i) {
+        node->children[i - 1] = node->children[i];
+    }
+    --node->count;
+
+    resource->deallocate(sibling, sizeof(BNode), alignof(BNode));
+}
 
 /**
- * @brief Recursively adds a course to the tree.
+ * @brief Makes sure a child has at least MIN_DEGREE keys before descending.
  *
- * Maintains BST ordering and AVL balance.
+ * Borrows a key through the parent from a sibling that can spare one, or 
+ * merges with a sibling otherwise.
  *
- * @param node The current node.
- * @param course The course to add.
- * @return New root of the modified subtree.
+ * @param node Parent of the child.
+ * @param index Index of the child to fill.
  */
-unique_ptr<Node> BinarySearchTree::addNode(unique_ptr<Node> node, Course course) {
-    // If node is empty
-    if (!node) {
-        return make_unique<Node>(course);
+void CourseBTree::fillChild(BNode* node, int index) {
+    BNode* child = node->children[index];
+
+    // Borrow from the left sibling
+    if (index > 0 && node->children[index - 1]->count >= MIN_DEGREE) {
+        BNode* sibling = node->children[index - 1];
+
+        for (int i = child->count - 1; i >= 0; --i) {
+            child->keys[i + 1] = child->keys[i];
+            child->courses[i + 1] = child->courses[i];
+        }
+        if (!child->leaf) {
+            for (int i = child->count; i >= 0; --i) {
+                child->children[i + 1] = child->children[i];
+            }
+            child->children[0] = sibling->children[sibling->count];
+        }
+        child->keys[0] = node->keys[index - 1];
+        child->courses[0] = node->courses[index - 1];
+        node->keys[index - 1] = sibling->keys[sibling->count - 1];
+        node->courses[index - 1] = sibling->courses[sibling->count - 1];
+        ++child->count;
+        --sibling->count;
+    }
+    // Borrow from the right sibling
+    else if (index < node->count && node->children[index + 1]->count >= MIN_DEGREE) {
+        BNode* sibling = node->children[index + 1];
+
+        child->keys[child->count] = node->keys[index];
+        child->courses[child->count] = node->courses[index];
+        if (!child->leaf) {
+            child->children[child->count + 1] = sibling->children[0];
+        }
+        node->keys[index] = sibling->keys[0];
+        node->courses[index] = sibling->courses[0];
+
+        for (int i = 1; i < sibling->count; ++i) {
+            sibling->keys[i - 1] = sibling->keys[i];
+            sibling->courses[i - 1] = sibling->courses[i];
+        }
+        if (!sibling->leaf) {
+            for (int i = 1; i <= sibling->count; ++i) {
+                sibling->children[i - 1] = sibling->children[i];
+            }
+        }
+        ++child->count;
+        --sibling->count;
     }
-    // If courseId is smaller than course.courseId, add to left.
-    if (course.courseId < node->course.courseId) {
-        node->left = addNode(move(node->left), course);
+    // Merge with a sibling
+    else if (index < node->count) {
+        mergeChildren(node, index);
     }
-    // Else, add to right.
     else {
-        node->right = addNode(move(node->right), course);
+        mergeChildren(node, index - 1);
     }
-    // Rebalance the tree
-    return rebalance(move(node));
 }
 
 /**
- * @brief Recursively removes a course from the tree.
+ * @brief Removes a key from a subtree and returns its course.
  *
- * Handles cases for nodes with 0, 1, or 2 children.
+ * Every node visited on the way down has at least MIN_DEGREE keys, so the 
+ * removal never has to walk back up the tree. Internal keys are replaced 
+ * by their predecessor or successor by moving the course pointer.
  *
- * @param node The current node.
- * @param courseId The ID of the course to remove.
- * @return New root of the modified subtree.
+ * @param node Root of the subtree (recursive).
+ * @param key Packed key to remove.
+ * @param courseId ID of the course to remove.
+ * @return The detached course, or nullptr if it was not found.
  */
-unique_ptr<Node> BinarySearchTree::removeNode(unique_ptr<Node> node, const string& courseId) {
-    if (!node) {
-        return node;
-    }
-    if (courseId < node->course.courseId) {
-        node->left = removeNode(move(node->left), courseId);
-    }
-    else if (courseId > node->course.courseId) {
-        node->right = removeNode(move(node->right), courseId);
-    }
-    else {
-        // If No Left Child Nodes
-        if (!node->left) {
-            return move(node->right);
+Course* CourseBTree::removeFrom(BNode* node, const CourseKey& key, string_view courseId) {
+    int index = findPosition(node, key, courseId);
+
+    if (matches(node, index, key, courseId)) {
+        Course* removed = node->courses[index];
+
+        // Key is in a leaf
+        if (node->leaf) {
+            for (int i = index + 1; i < node->count; ++i) {
+                node->keys[i - 1] = node->keys[i];
+                node->courses[i - 1] = node->courses[i];
+            }
+            --node->count;
+            return removed;
+        }
+
+        // Replace with the predecessor
+        if (node->children[index]->count >= MIN_DEGREE) {
+            BNode* predecessor = node->children[index];
+            while (!predecessor->leaf) {
+                predecessor = predecessor->children[predecessor->count];
+            }
+            CourseKey predecessorKey = predecessor->keys[predecessor->count - 1];
+            Course* predecessorCourse = predecessor->courses[predecessor->count - 1];
+
+            removeFrom(node->children[index], predecessorKey, predecessorCourse->courseId);
+            node->keys[index] = predecessorKey;
+            node->courses[index] = predecessorCourse;
+            return removed;
         }
 
-        // If No Right Child Nodes
-        if (!node->right) {
-            return move(node->left);
+        // Replace with the successor
+        if (node->children[index + 1]->count >= MIN_DEGREE) {
+            BNode* successor = node->children[index + 1];
+            while (!successor->leaf) {
+                successor = successor->children[0];
+            }
+            CourseKey successorKey = successor->keys[0];
+            Course* successorCourse = successor->courses[0];
+
+            removeFrom(node->children[index + 1], successorKey, successorCourse->courseId);
+            node->keys[index] = successorKey;
+            node->courses[index] = successorCourse;
+            return removed;
         }
 
-        // Two Child Nodes
-        Node* minLargerNode = node->right.get();
-        while (minLargerNode->left) {
-            minLargerNode = minLargerNode->left.get();
+        // Both neighbours are minimal, so merge them around the key
+        mergeChildren(node, index);
+        return removeFrom(node->children[index], key, courseId);
+    }
+
+    if (node->leaf) {
+        return nullptr;
+    }
+
+    // Make sure the child we descend into can lose a key
+    if (node->children[index]->count < MIN_DEGREE) {
+        fillChild(node, index);
+        if (index > node->count) {
+            --index;
         }
-        node->course = minLargerNode->course;
-        node->right = removeNode(move(node->right), minLargerNode->course.courseId);
     }
-    // Rebalance the tree
-    return rebalance(move(node));
+    return removeFrom(node->children[index], key, courseId);
 }
 
 /**
- * @brief Recursively searches for a course in the tree.
+ * @brief Passes every course of a subtree to a visitor in ascending order.
  *
- * Performs binary search based on course ID.
+ * Recursion depth is the height of the B-tree, which stays at log_4(n).
  *
- * @param node The current node.
- * @param courseId The course ID to search for.
- * @return Pointer to the found node or nullptr.
+ * @param node Root of the subtree (recursive).
+ * @param visit Callable taking a const Course&.
  */
-Node* BinarySearchTree::searchNode(Node* node, const string& courseId) {
-    if (node == nullptr || node->course.courseId == courseId) {
-        return node;
-    }
-    if (courseId < node->course.courseId) {
-        return searchNode(node->left.get(), courseId);
-    }
-    else {
-        return searchNode(node->right.get(), courseId);
+template <typename Visitor>
+void CourseBTree::visitInOrder(const BNode* node, Visitor& visit) {
+    if (node) {
+        for (int i = 0; i < node->count; ++i) {
+            if (!node->leaf) {
+                visitInOrder(node->children[i], visit);
+            }
+            visit(static_cast<const Course&>(*node->courses[i]));
+        }
+        if (!node->leaf) {
+            visitInOrder(node->children[node->count], visit);
+        }
     }
 }
 
-//============================================================================
-// Public Class Methods
-//============================================================================
-
 /**
- * @brief Traverses the entire tree in in-order sequence.
+ * @brief Inserts a course. The caller is responsible for rejecting duplicates.
  *
- * Calls the recursive inOrder() starting at the root.
+ * @param course The course to insert.
+ * @return Pointer to the stored course.
  */
-void BinarySearchTree::InOrder() {
-    inOrder(root);
+const Course* CourseBTree::Insert(Course course) {
+    Course* stored = createCourse(move(course));
+    CourseKey key = CourseKey::Pack(stored->courseId);
+
+    if (!root) {
+        root = createNode(true);
+    }
+    if (root->count == MAX_KEYS) {
+        BNode* newRoot = createNode(false);
+        newRoot->children[0] = root;
+        splitChild(newRoot, 0);
+        root = newRoot;
+    }
+    insertNonFull(root, key, stored);
+    return stored;
 }
 
 /**
- * @brief Traverses the entire tree in post-order sequence.
+ * @brief Removes a course.
  *
- * Calls the recursive postOrder() starting at the root.
+ * @param courseId ID of the course to remove.
+ * @return True if the course was found and removed.
  */
-void BinarySearchTree::PostOrder() {
-    postOrder(root);
+bool CourseBTree::Remove(string_view courseId) {
+    if (!root) {
+        return false;
+    }
+
+    Course* removed = removeFrom(root, CourseKey::Pack(courseId), courseId);
+
+    // Shrink the tree when the root runs out of keys
+    if (root->count == 0) {
+        BNode* oldRoot = root;
+        root = root->leaf ? nullptr : root->children[0];
+        resource->deallocate(oldRoot, sizeof(BNode), alignof(BNode));
+    }
+
+    if (removed) {
+        destroyCourse(removed);
+    }
+    return removed != nullptr;
 }
 
 /**
- * @brief Traverses the entire tree in pre-order sequence.
+ * @brief Searches for a course.
  *
- * Calls the recursive preOrder() starting at the root.
+ * @param courseId The course ID to search for.
+ * @return Pointer to the stored course, or nullptr if not found.
  */
-void BinarySearchTree::PreOrder() {
-    preOrder(root);
+const Course* CourseBTree::Search(string_view courseId) const {
+    const CourseKey key = CourseKey::Pack(courseId);
+    const BNode* node = root;
+
+    while (node) {
+        int index = findPosition(node, key, courseId);
+        if (matches(node, index, key, courseId)) {
+            return node->courses[index];
+        }
+        node = node->leaf ? nullptr : node->children[index];
+    }
+    return nullptr;
 }
 
 /**
- * @brief Inserts a course into the tree.
+ * @brief Passes the courses of a subtree from a starting ID onward to a visitor.
  *
- * Throws a DuplicateCourseException if the course ID already exists.
+ * Keys and children before the starting ID are skipped without being 
+ * visited, so reaching the first course costs one root-to-leaf descent.
  *
- * @param course The course to insert.
- * @throws DuplicateCourseException if the course ID is already in the tree.
+ * @param node Root of the subtree (recursive).
+ * @param key Packed starting ID.
+ * @param courseId The starting ID.
+ * @param visit Callable taking a const Course& and returning false to stop.
+ * @return False if the visitor stopped the scan.
  */
-void BinarySearchTree::Insert(Course course) {
-    if (Search(course.courseId).courseId.empty()) {
-        root = addNode(move(root), course);
+template <typename Visitor>
+bool CourseBTree::visitFrom(const BNode* node, const CourseKey& key, string_view courseId, Visitor& visit) {
+    if (!node) {
+        return true;
     }
-    else {
-        throw DuplicateCourseException(course.courseId);
+
+    for (int i = findPosition(node, key, courseId); i < node->count; ++i) {
+        if (!node->leaf && !visitFrom(node->children[i], key, courseId, visit)) {
+            return false;
+        }
+        if (!visit(static_cast<const Course&>(*node->courses[i]))) {
+            return false;
+        }
     }
+    return node->leaf || visitFrom(node->children[node->count], key, courseId, visit);
 }
 
 /**
- * @brief Removes a course from the tree.
+ * @brief Passes every course to a visitor in ascending order.
  *
- * @param courseId The ID of the course to remove.
+ * @param visit Callable taking a const Course&.
  */
-void BinarySearchTree::Remove(const string& courseId) {
-    root = removeNode(move(root), courseId);
+template <typename Visitor>
+void CourseBTree::VisitInOrder(Visitor&& visit) const {
+    visitInOrder(root, visit);
 }
 
 /**
- * @brief Searches for a course in the tree.
+ * @brief Passes courses to a visitor in ascending order, starting at an ID.
  *
- * @param courseId The ID of the course to search for.
- * @return The course if found, or an empty Course object if not.
+ * @param courseId Smallest course ID to visit.
+ * @param visit Callable taking a const Course& and returning false to stop.
  */
-Course BinarySearchTree::Search(string courseId) {
-    Node* result = searchNode(root.get(), courseId);
-    return result ? result->course : Course();
+template <typename Visitor>
+void CourseBTree::VisitFrom(string_view courseId, Visitor&& visit) const {
+    visitFrom(root, CourseKey::Pack(courseId), courseId, visit);
 }
 
+/**
+ * @brief Forgets every node without destroying it.
+ *
+ * Used after the owning arena has already released the memory.
+ */
+void CourseBTree::Abandon() {
+    root = nullptr;
+}
 
 //============================================================================
-// Static Methods for Testing
+// Hash Index
 //============================================================================
 
 /**
- * @brief Displays a single course and its prerequisites.
+ * @class CourseHashIndex
+ * @brief Open-addressing hash index from course ID to stored course.
  *
- * Outputs the course ID, name, and all prerequisites to standard output.
+ * Uses Robin Hood probing: an inserted entry displaces any entry that is 
+ * closer to its home slot, which keeps probe sequences short and lets a 
+ * lookup stop as soon as it passes the point where its key would have been.
+ * Removal shifts the following entries back instead of leaving tombstones.
+ * Slots hold the packed key, so probing compares integers and only reads a 
+ * course on a hit. The index does not own the courses it points to.
+ */
+class CourseHashIndex {
+
+    private:
+        struct Slot {
+            CourseKey key;          /// Packed course ID
+            const Course* course;   /// Indexed course, or nullptr if the slot is empty
+        };
+
+        vector<Slot> slots;         /// Table size is always a power of two
+        size_t count;               /// Number of occupied slots
+
+        size_t probeDistance(const CourseKey& key, size_t index) const;
+        size_t findSlot(const CourseKey& key, string_view courseId) const;
+        void place(Slot entry);
+        void grow();
+        void rehash(size_t slotCount);
+
+    public:
+        static constexpr size_t INITIAL_SLOTS = 64;
+
+        CourseHashIndex();
+
+        const Course* Find(string_view courseId) const;
+        void Insert(const Course* course);
+        bool Erase(string_view courseId);
+        void Reserve(size_t entries);
+        void Clear();
+        size_t Size() const;
+};
+
+/**
+ * @brief Constructs an empty index.
+ */
+CourseHashIndex::CourseHashIndex() {
+    count = 0;
+}
+
+/**
+ * @brief Returns how far a slot is from the home slot of the key it holds.
+ *
+ * @param key The packed key stored in the slot.
+ * @param index The slot's position.
+ * @return Number of probes between the home slot and index.
+ */
+size_t CourseHashIndex::probeDistance(const CourseKey& key, size_t index) const {
+    size_t mask = slots.size() - 1;
+    return (index - (hashCourseKey(key) & mask)) & mask;
+}
+
+/**
+ * @brief Finds the slot holding a course ID.
+ *
+ * @param key Packed course ID to look for.
+ * @param courseId The course ID to look for.
+ * @return Index of the slot, or slots.size() if the ID is not indexed.
+ */
+size_t CourseHashIndex::findSlot(const CourseKey& key, string_view courseId) const {
+    if (slots.empty()) {
+        return 0;
+    }
+
+    size_t mask = slots.size() - 1;
+    size_t index = hashCourseKey(key) & mask;
+
+    for (size_t distance = 0; ; ++distance) {
+        const Slot& slot = slots[index];
+
+        // An empty slot or a richer entry means the key would have been here
+        if (!slot.course || probeDistance(slot.key, index) < distance) {
+            return slots.size();
+        }
+        if (matchesCourseKey(slot.key, *slot.course, key, courseId)) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/**
+ * @brief Places an entry, displacing entries closer to their home slot.
+ *
+ * @param entry The entry to place. Its course ID must not already be indexed.
+ */
+void CourseHashIndex::place(Slot entry) {
+    size_t mask = slots.size() - 1;
+    size_t index = hashCourseKey(entry.key) & mask;
+
+    for (size_t distance = 0; ; ++distance) {
+        Slot& slot = slots[index];
+
+        if (!slot.course) {
+            slot = entry;
+            return;
+        }
+
+        // Robin Hood: take the slot from an entry that has travelled less
+        size_t existingDistance = probeDistance(slot.key, index);
+        if (existingDistance < distance) {
+            swap(slot, entry);
+            distance = existingDistance;
+        }
+        index = (index + 1) & mask;
+    }
+}
+
+/**
+ * @brief Doubles the table and re-places every entry.
+ */
+void CourseHashIndex::grow() {
+    rehash(max(slots.size() * 2, INITIAL_SLOTS));
+}
+
+/**
+ * @brief Moves every entry into a table of the given size.
+ *
+ * @param slotCount New table size; must be a power of two.
+ */
+void CourseHashIndex::rehash(size_t slotCount) {
+    vector<Slot> old(slotCount, Slot{ CourseKey{ 0, 0 }, nullptr });
+    old.swap(slots);
+
+    for (const Slot& slot : old) {
+        if (slot.course) {
+            place(slot);
+        }
+    }
+}
+
+/**
+ * @brief Looks up a course by ID.
+ *
+ * @param courseId The course ID to look for.
+ * @return Pointer to the indexed course, or nullptr if not found.
+ */
+const Course* CourseHashIndex::Find(string_view courseId) const {
+    size_t index = findSlot(CourseKey::Pack(courseId), courseId);
+    return index < slots.size() ? slots[index].course : nullptr;
+}
+
+/**
+ * @brief Adds a course to the index. The caller must reject duplicates first.
+ *
+ * @param course The stored course to index.
+ */
+void CourseHashIndex::Insert(const Course* course) {
+    // Keep the load factor at or below 7/8
+    if ((count + 1) * 8 > slots.size() * 7) {
+        grow();
+    }
+    place(Slot{ CourseKey::Pack(course->courseId), course });
+    ++count;
+}
+
+/**
+ * @brief Removes a course ID from the index.
+ *
+ * @param courseId The course ID to remove.
+ * @return True if the ID was indexed.
+ */
+bool CourseHashIndex::Erase(string_view courseId) {
+    size_t index = findSlot(CourseKey::Pack(courseId), courseId);
+    if (index >= slots.size()) {
+        return false;
+    }
+
+    // Shift the following entries back until one is already at home
+    size_t mask = slots.size() - 1;
+    size_t next = (index + 1) & mask;
+    while (slots[next].course && probeDistance(slots[next].key, next) > 0) {
+        slots[index] = slots[next];
+        index = next;
+        next = (next + 1) & mask;
+    }
+    slots[index] = Slot{ CourseKey{ 0, 0 }, nullptr };
+    --count;
+    return true;
+}
+
+/**
+ * @brief Grows the table once so that it can hold the given number of entries.
+ *
+ * @param entries Number of entries expected.
+ */
+void CourseHashIndex::Reserve(size_t entries) {
+    size_t slotCount = max(slots.size(), INITIAL_SLOTS);
+    while (entries * 8 > slotCount * 7) {
+        slotCount *= 2;
+    }
+    if (slotCount != slots.size()) {
+        rehash(slotCount);
+    }
+}
+
+/**
+ * @brief Removes every entry and releases the table.
+ */
+void CourseHashIndex::Clear() {
+    slots.clear();
+    slots.shrink_to_fit();
+    count = 0;
+}
+
+/**
+ * @brief Returns the number of indexed courses.
+ *
+ * @return Number of entries.
+ */
+size_t CourseHashIndex::Size() const {
+    return count;
+}
+
+//============================================================================
+// Binary Search Tree Class Definition
+//============================================================================
+
+/**
+ * @brief Storage structure behind a BinarySearchTree.
+ */
+enum class TreeBackend {
+    AVL,    /// Self-balancing binary tree (default)
+    BTree   /// Cache-line-sized B-tree nodes, fewer cache misses per lookup
+};
+
+/**
+ * @class BinarySearchTree
+ * @brief AVL-based binary search tree that stores and manages course data.
+ *
+ * Supports node insertion, search, traversal, deletion, and self-balancing.
+ * A tree constructed with TreeBackend::BTree keeps its courses in a 
+ * CourseBTree instead and supports the same Insert, Remove, Search and 
+ * InOrder operations.
+ */
+class BinarySearchTree {
+
+    public:
+        class const_iterator;
+        using iterator = const_iterator;
+
+    private:
+        /// Link used to chain recycled node slots inside the arena.
+        struct FreeSlot {
+            FreeSlot* next;
+        };
+
+        Node* root;
+        pmr::memory_resource* resource;                 /// Source of node and string memory
+        unique_ptr<pmr::monotonic_buffer_resource> arena; /// Owned arena, or null when heap-backed
+        FreeSlot* freeSlots;                            /// Node slots released by Remove()
+        unique_ptr<CourseBTree> btree;                  /// B-tree storage, or null for the AVL backend
+        CourseHashIndex index;                          /// Course ID to course, kept in sync with the tree
+        vector<unique_ptr<pmr::monotonic_buffer_resource>> taskArenas; /// Arenas filled by worker threads
+        mutex taskArenaMutex;                           /// Guards taskArenas
+
+        // Node Storage Methods
+        Node* createNode(Course course);
+        void destroyNode(Node* node);
+
+        // AVL Support & Helper Methods
+        int height(const Node* node);
+        static size_t size(const Node* node);
+        void updateNode(Node* node);
+        Node* leftRotate(Node* node);
+        Node* rightRotate(Node* node);
+        Node* rebalance(Node* node);
+        void relink(Node* parent, const Node* child, Node* replacement);
+        void retrace(Node* const* path, int depth, bool grew);
+        void insertNode(Node* added);
+        void removeNode(const CourseKey& key, string_view courseId);
+        Node* buildBalanced(vector<Course>& courses, const vector<size_t>& rows, size_t first, size_t last,
+                            pmr::memory_resource* memory);
+        Node* buildParallel(vector<Course>& courses, const vector<size_t>& rows, unsigned threads);
+
+        // Join-Based Set Operation Helpers
+        pmr::memory_resource* createTaskArena();
+        Node* cloneSubtree(const Node* node, pmr::memory_resource* memory, int parallelDepth);
+        Node* join(Node* left, Node* middle, Node* right);
+        Node* joinPair(Node* left, Node* right);
+        Node* detachMin(Node* node, Node*& minimum);
+        Node* split(Node* node, const CourseKey& key, string_view courseId, Node*& less, Node*& greater);
+        Node* unionNodes(Node* a, Node* b, int parallelDepth);
+        Node* intersectNodes(Node* a, Node* b, int parallelDepth);
+        Node* subtractNodes(Node* a, Node* b, int parallelDepth);
+        Node* changedNodes(Node* a, Node* b, int parallelDepth);
+        void reindex();
+        template <typename Operation>
+        static unique_ptr<BinarySearchTree> combine(const BinarySearchTree& a, const BinarySearchTree& b, Operation operation);
+
+        void requireAVL(const char* operation) const;
+        template <typename Visitor>
+        void scanFrom(string_view courseId, Visitor&& visit) const;
+        const_iterator seek(size_t position) const;
+
+    public:
+        /// Initial slab size for a tree's arena; later slabs grow geometrically.
+        static constexpr size_t ARENA_SLAB_BYTES = 64 * 1024;
+        /// Longest root-to-leaf path that iterators and visitors can follow. 
+        /// An AVL tree this tall would need over 10^13 nodes.
+        static constexpr int MAX_DEPTH = 64;
+
+        // Constructors & Destructor
+        BinarySearchTree();
+        explicit BinarySearchTree(pmr::memory_resource* heap);
+        explicit BinarySearchTree(TreeBackend backend);
+        ~BinarySearchTree();
+
+        // Trees own their nodes through raw pointers, so copying is disabled.
+        BinarySearchTree(const BinarySearchTree&) = delete;
+        BinarySearchTree& operator=(const BinarySearchTree&) = delete;
+
+        // Traversal Methods
+        void InOrder();
+        void PostOrder();
+        void PreOrder();
+        template <typename Visitor>
+        void VisitInOrder(Visitor&& visit) const;
+        template <typename Visitor>
+        void VisitPreOrder(Visitor&& visit) const;
+        template <typename Visitor>
+        void VisitPostOrder(Visitor&& visit) const;
+
+        // Iterator Methods
+        const_iterator begin() const;
+        const_iterator end() const;
+        const_iterator lower_bound(string_view courseId) const;
+
+        // Order Statistic Methods
+        size_t Size() const;
+        size_t Rank(string_view courseId) const;
+        const Course* Select(size_t position) const;
+        template <typename Visitor>
+        size_t VisitPage(size_t page, size_t pageSize, Visitor&& visit) const;
+
+        // Scan Methods
+        template <typename Visitor>
+        size_t RangeScan(string_view first, string_view last, Visitor&& visit) const;
+        template <typename Visitor>
+        size_t PrefixScan(string_view prefix, Visitor&& visit) const;
+
+        // Set Operation Methods
+        static unique_ptr<BinarySearchTree> Union(const BinarySearchTree& a, const BinarySearchTree& b);
+        static unique_ptr<BinarySearchTree> Intersection(const BinarySearchTree& a, const BinarySearchTree& b);
+        static unique_ptr<BinarySearchTree> Difference(const BinarySearchTree& a, const BinarySearchTree& b);
+        static unique_ptr<BinarySearchTree> Diff(const BinarySearchTree& before, const BinarySearchTree& after);
+
+        // Core Tree Operation Methods
+        void Insert(Course course);
+        vector<size_t> BulkLoad(vector<Course>& courses, unsigned threads = 0);
+        void Remove(string_view courseId);
+        Course Search(string_view courseId) const;
+        const Course* Find(string_view courseId) const;
+        bool Contains(string_view courseId) const;
+        void Clear();
+        Course::allocator_type Allocator() const;
+
+        /**
+         * @class DuplicateCourseException
+         * @brief Exception thrown when attempting to insert a course with a duplicate ID.
+         */
+        class DuplicateCourseException : public exception {
+            string message;
+        public:
+            explicit DuplicateCourseException(string_view courseId) {
+                message = "Duplicate course ID \"" + string(courseId) + "\" was ignored.";
+            }
+            const char* what() const noexcept override {
+                return message.c_str();
+            }
+        };
+};
+
+/**
+ * @class BinarySearchTree::const_iterator
+ * @brief Bidirectional iterator over the courses of an AVL tree in ID order.
+ *
+ * Holds the path from the root to the current node in a fixed-size array, 
+ * so stepping never allocates and needs no parent links in the nodes. The 
+ * end iterator has an empty path; decrementing it moves to the last course.
+ * Any Insert(), Remove() or Clear() invalidates every iterator.
+ */
+class BinarySearchTree::const_iterator {
+
+    private:
+        const Node* root;
+        const Node* path[MAX_DEPTH];    /// path[depth - 1] is the current node
+        int depth;
+
+        void push(const Node* node);
+        void descendLeft(const Node* node);
+        void descendRight(const Node* node);
+
+        friend class BinarySearchTree;
+
+    public:
+        using iterator_category = bidirectional_iterator_tag;
+        using value_type = Course;
+        using difference_type = ptrdiff_t;
+        using pointer = const Course*;
+        using reference = const Course&;
+
+        const_iterator();
+        explicit const_iterator(const Node* root);
+
+        reference operator*() const;
+        pointer operator->() const;
+        const_iterator& operator++();
+        const_iterator operator++(int);
+        const_iterator& operator--();
+        const_iterator operator--(int);
+        bool operator==(const const_iterator& other) const;
+        bool operator!=(const const_iterator& other) const;
+};
+
+/**
+ * @brief Default constructor for BinarySearchTree.
+ *
+ * Nodes and their strings are carved out of large slabs owned by the tree, 
+ * so loading a catalog costs a handful of allocations instead of several 
+ * per course, and Clear() frees everything at once.
+ */
+BinarySearchTree::BinarySearchTree() {
+    root = nullptr;
+    arena = make_unique<pmr::monotonic_buffer_resource>(ARENA_SLAB_BYTES);
+    resource = arena.get();
+    freeSlots = nullptr;
+}
+
+/**
+ * @brief Constructs a heap-backed BinarySearchTree.
+ *
+ * Every node and string is allocated and freed individually from the given 
+ * memory resource. This is mainly useful as a baseline when benchmarking 
+ * the arena-backed tree.
+ *
+ * @param heap Memory resource to allocate from (e.g. pmr::new_delete_resource()).
+ */
+BinarySearchTree::BinarySearchTree(pmr::memory_resource* heap) {
+    root = nullptr;
+    resource = heap;
+    freeSlots = nullptr;
+}
+
+/**
+ * @brief Constructs an arena-backed tree with the given storage structure.
+ *
+ * @param backend TreeBackend::AVL or TreeBackend::BTree.
+ */
+BinarySearchTree::BinarySearchTree(TreeBackend backend) : BinarySearchTree() {
+    if (backend == TreeBackend::BTree) {
+        btree = make_unique<CourseBTree>(resource);
+    }
+}
+
+/**
+ * @brief Destructor for BinarySearchTree.
+ */
+BinarySearchTree::~BinarySearchTree() {
+    Clear();
+}
+
+//============================================================================
+// Private Class Methods
+//============================================================================
+
+/**
+ * @brief Allocates and constructs a node for a course.
+ *
+ * Reuses a slot released by Remove() when one is available. The course's 
+ * strings are copied into the tree's memory resource.
+ *
+ * @param course The course to store.
+ * @return Pointer to the new node.
+ */
+Node* BinarySearchTree::createNode(Course course) {
+    void* slot;
+
+    if (freeSlots) {
+        slot = freeSlots;
+        freeSlots = freeSlots->next;
+    }
+    else {
+        slot = resource->allocate(sizeof(Node), alignof(Node));
+    }
+    return new (slot) Node(move(course), Course::allocator_type(resource));
+}
+
+/**
+ * @brief Destroys a single node that has been unlinked from the tree.
+ *
+ * Arena-backed trees keep the slot for reuse, since a monotonic arena 
+ * cannot return individual blocks.
+ *
+ * @param node The node to destroy.
+ */
+void BinarySearchTree::destroyNode(Node* node) {
+    node->~Node();
+
+    if (arena) {
+        FreeSlot* slot = new (node) FreeSlot{ freeSlots };
+        freeSlots = slot;
+    }
+    else {
+        resource->deallocate(node, sizeof(Node), alignof(Node));
+    }
+}
+
+/**
+ * @brief Returns the height of a node in the tree.
+ *
+ * Used for AVL balancing. If the node is null, returns -1.
+ *
+ * @param node Pointer to the node.
+ * @return Height of the node, or -1 if null.
+ */
+int BinarySearchTree::height(const Node* node) {
+    return node ? node->height : -1;
+}
+
+/**
+ * @brief Returns the number of nodes in a subtree.
+ *
+ * @param node Root of the subtree.
+ * @return Subtree size, or 0 if null.
+ */
+size_t BinarySearchTree::size(const Node* node) {
+    return node ? node->size : 0;
+}
+
+/**
+ * @brief Updates the height and subtree size of a node based on its children.
+ *
+ * Called after modifications to the subtree (e.g., insert, remove, rotation).
+ *
+ * @param node Pointer to the node.
+ */
+void BinarySearchTree::updateNode(Node* node) {
+    if (node) {
+        node->height = max(height(node->left), height(node->right)) + 1;
+        node->size = size(node->left) + size(node->right) + 1;
+    }
+}
+
+/**
+ * @brief Performs a left rotation on the subtree rooted at node.
+ *
+ * Used for rebalancing AVL trees when right-heavy.
+ *
+ * @param node Root of the unbalanced subtree.
+ * @return New root after rotation.
+ */
+Node* BinarySearchTree::leftRotate(Node* node) {
+    Node* rightChild = node->right;
+    node->right = rightChild->left;
+    rightChild->left = node;
+
+    updateNode(rightChild->left);
+    updateNode(rightChild);
+
+    return rightChild;
+}
+
+/**
+ * @brief Performs a right rotation on the subtree rooted at node.
+ *
+ * Used for rebalancing AVL trees when left-heavy.
+ *
+ * @param node Root of the unbalanced subtree.
+ * @return New root after rotation.
+ */
+Node* BinarySearchTree::rightRotate(Node* node) {
+    Node* leftChild = node->left;
+    node->left = leftChild->right;
+    leftChild->right = node;
+
+    updateNode(leftChild->right);
+    updateNode(leftChild);
+
+    return leftChild;
+}
+
+
+/**
+ * @brief Rebalances a node if it has become unbalanced.
+ *
+ * Handles left-left, left-right, right-right, and right-left cases.
+ *
+ * @param node The subtree root to check and rebalance.
+ * @return Root of the balanced subtree.
+ */
+Node* BinarySearchTree::rebalance(Node* node) {
+    if (!node) {
+        return node;
+    }
+
+    updateNode(node);
+    int balance = height(node->left) - height(node->right);
+
+    // Left Heavy
+    if (balance > 1) {
+        // Left-Left
+        if (height(node->left->left) >= height(node->left->right)) {
+            return rightRotate(node);
+        }
+        // Left-Right
+        else {
+            node->left = leftRotate(node->left);
+            return rightRotate(node);
+        }
+    }
+    // Right Heavy
+    else if (balance < -1) {
+        // Right-Right
+        if (height(node->right->right) >= height(node->right->left)) {
+            return leftRotate(node);
+        }
+        // Right-Left
+        else {
+            node->right = rightRotate(node->right);
+            return leftRotate(node);
+        }
+    }
+
+    return node;
+} 
+
+/**
+ * @brief Points a parent (or the root) at a replacement for one of its children.
+ *
+ * @param parent The parent node, or nullptr if child is the root.
+ * @param child The current child.
+ * @param replacement The subtree to put in child's place.
+ */
+void BinarySearchTree::relink(Node* parent, const Node* child, Node* replacement) {
+    if (!parent) {
+        root = replacement;
+    }
+    else if (parent->left == child) {
+        parent->left = replacement;
+    }
+    else {
+        parent->right = replacement;
+    }
+}
+
+/**
+ * @brief Restores AVL balance and subtree sizes along a search path.
+ *
+ * Walks from the deepest node back towards the root, rebalancing each one, 
+ * until a subtree comes out the same height it went in; nothing above that 
+ * point can be out of balance, so the remaining ancestors only have their 
+ * size adjusted.
+ *
+ * @param path Nodes from the root down to the parent of the change.
+ * @param depth Number of nodes in path.
+ * @param grew True after an insert, false after a remove.
+ */
+void BinarySearchTree::retrace(Node* const* path, int depth, bool grew) {
+    int level = depth - 1;
+
+    while (level >= 0) {
+        Node* node = path[level];
+        int before = node->height;
+        Node* subtree = rebalance(node);
+
+        relink(level > 0 ? path[level - 1] : nullptr, node, subtree);
+        --level;
+        if (subtree->height == before) {
+            break;
+        }
+    }
+    for (; level >= 0; --level) {
+        if (grew) {
+            ++path[level]->size;
+        }
+        else {
+            --path[level]->size;
+        }
+    }
+}
+
+/**
+ * @brief Links a new node into the tree.
+ *
+ * Records the search path in a fixed-size stack instead of recursing, then 
+ * retraces it.
+ *
+ * @param added The node to add; its ID must not already be in the tree.
+ */
+void BinarySearchTree::insertNode(Node* added) {
+    Node* path[MAX_DEPTH];
+    int depth = 0;
+    bool goLeft = false;
+
+    for (Node* node = root; node; node = goLeft ? node->left : node->right) {
+        path[depth++] = node;
+        goLeft = compareCourseKeys(node->key, node->course, added->key, added->course.courseId) > 0;
+    }
+
+    if (depth == 0) {
+        root = added;
+        return;
+    }
+    if (goLeft) {
+        path[depth - 1]->left = added;
+    }
+    else {
+        path[depth - 1]->right = added;
+    }
+    retrace(path, depth, true);
+}
+
+/**
+ * @brief Unlinks and destroys the node holding a course ID.
+ *
+ * A node with two children is replaced by its in-order successor, which 
+ * is spliced into its place; no course is copied and the successor's 
+ * course stays at the same address, so the hash index stays valid.
+ *
+ * @param key Packed ID of the course to remove.
+ * @param courseId The ID of the course to remove.
+ */
+void BinarySearchTree::removeNode(const CourseKey& key, string_view courseId) {
+    Node* path[MAX_DEPTH];
+    int depth = 0;
+    Node* target = root;
+
+    while (target) {
+        int order = compareCourseKeys(target->key, target->course, key, courseId);
+        if (order == 0) {
+            break;
+        }
+        path[depth++] = target;
+        target = order > 0 ? target->left : target->right;
+    }
+    if (!target) {
+        return;
+    }
+
+    Node* parent = depth > 0 ? path[depth - 1] : nullptr;
+
+    // Zero or One Child Node
+    if (!target->left || !target->right) {
+        relink(parent, target, target->left ? target->left : target->right);
+    }
+    // Two Child Nodes
+    else {
+        int targetLevel = depth++;
+        Node* successor = target->right;
+        while (successor->left) {
+            path[depth++] = successor;
+            successor = successor->left;
+        }
+
+        // Detach the successor (its parent is target when it is target's right child)
+        relink(depth - 1 > targetLevel ? path[depth - 1] : target, successor, successor->right);
+
+        successor->left = target->left;
+        successor->right = target->right;
+        successor->height = target->height;
+        successor->size = target->size;
+        relink(parent, target, successor);
+        path[targetLevel] = successor;
+    }
+
+    destroyNode(target);
+    retrace(path, depth, false);
+}
+
+/**
+ * @brief Builds a perfectly balanced subtree from sorted courses.
+ *
+ * The middle course becomes the root and each half becomes a subtree, so 
+ * every node is created once and no rotations are needed. Heights are set 
+ * on the way back up. The hash index is not updated.
+ *
+ * @param courses The input courses; the ones used are moved from.
+ * @param rows Positions in courses of the unique IDs, in ascending ID order.
+ * @param first First position in rows to build from.
+ * @param last One past the last position in rows to build from.
+ * @param memory Where to allocate the nodes; only the calling thread may use it.
+ * @return Root of the new subtree.
+ */
+Node* BinarySearchTree::buildBalanced(vector<Course>& courses, const vector<size_t>& rows, size_t first, size_t last,
+                                      pmr::memory_resource* memory) {
+    if (first == last) {
+        return nullptr;
+    }
+
+    size_t middle = first + (last - first) / 2;
+    void* slot = memory->allocate(sizeof(Node), alignof(Node));
+    Node* node = new (slot) Node(move(courses[rows[middle]]), Course::allocator_type(memory));
+    node->left = buildBalanced(courses, rows, first, middle, memory);
+    node->right = buildBalanced(courses, rows, middle + 1, last, memory);
+    updateNode(node);
+    return node;
+}
+
+/**
+ * @brief Builds a balanced tree from sorted courses using several threads.
+ *
+ * The rows are cut into one contiguous chunk per thread. Each thread builds 
+ * a balanced subtree from its chunk in its own arena, and the subtrees are 
+ * then joined left to right, using the first course of each later chunk as 
+ * the middle node. The joins cost O(threads * log n) in total.
+ *
+ * @param courses The input courses; the ones used are moved from.
+ * @param rows Positions in courses of the unique IDs, in ascending ID order.
+ * @param threads Most threads to use.
+ * @return Root of the new tree.
+ */
+Node* BinarySearchTree::buildParallel(vector<Course>& courses, const vector<size_t>& rows, unsigned threads) {
+    size_t chunks = min<size_t>(max(1u, threads), rows.size() / PARALLEL_TREE_GRAIN);
+
+    // Heap-backed trees free nodes one by one, so every node must come from the heap
+    if (chunks < 2 || !arena) {
+        return buildBalanced(courses, rows, 0, rows.size(), resource);
+    }
+
+    vector<size_t> bounds;
+    for (size_t i = 0; i <= chunks; ++i) {
+        bounds.push_back(rows.size() * i / chunks);
+    }
+
+    // Chunk i covers [bounds[i], bounds[i + 1]); later chunks give up their first row as a separator
+    vector<Node*> parts(chunks);
+    vector<thread> workers;
+    for (size_t i = 0; i < chunks; ++i) {
+        pmr::memory_resource* memory = createTaskArena();
+        size_t first = bounds[i] + (i > 0 ? 1 : 0);
+        size_t last = bounds[i + 1];
+        workers.emplace_back([this, &courses, &rows, &parts, i, first, last, memory]() {
+            parts[i] = buildBalanced(courses, rows, first, last, memory);
+        });
+    }
+    for (thread& worker : workers) {
+        worker.join();
+    }
+
+    Node* tree = parts[0];
+    for (size_t i = 1; i < chunks; ++i) {
+        Node* middle = buildBalanced(courses, rows, bounds[i], bounds[i] + 1, resource);
+        tree = join(tree, middle, parts[i]);
+    }
+    return tree;
+}
+
+/**
+ * @brief Adds an arena for one worker thread to allocate from.
+ *
+ * Monotonic arenas are not thread-safe, so each parallel task that creates 
+ * nodes gets its own. The arenas live until Clear().
+ *
+ * @return The new arena.
+ */
+pmr::memory_resource* BinarySearchTree::createTaskArena() {
+    lock_guard<mutex> lock(taskArenaMutex);
+    taskArenas.push_back(make_unique<pmr::monotonic_buffer_resource>(ARENA_SLAB_BYTES));
+    return taskArenas.back().get();
+}
+
+/**
+ * @brief Copies a subtree of another tree into memory owned by this tree.
+ *
+ * The copy keeps the source's shape, heights and sizes. Large subtrees are 
+ * copied by two tasks at once while parallelDepth allows, the second task 
+ * filling its own arena.
+ *
+ * @param node Root of the subtree to copy (recursive).
+ * @param memory Where the calling thread allocates.
+ * @param parallelDepth Remaining levels at which to fork a task.
+ * @return Root of the copy.
+ */
+Node* BinarySearchTree::cloneSubtree(const Node* node, pmr::memory_resource* memory, int parallelDepth) {
+    if (!node) {
+        return nullptr;
+    }
+
+    void* slot = memory->allocate(sizeof(Node), alignof(Node));
+    Course::allocator_type alloc(memory);
+    Node* copy = new (slot) Node(Course(node->course, alloc), alloc);
+
+    if (parallelDepth > 0 && node->size >= PARALLEL_TREE_GRAIN) {
+        pmr::memory_resource* taskMemory = createTaskArena();
+        future<Node*> left = async(launch::async, [this, node, taskMemory, parallelDepth]() {
+            return cloneSubtree(node->left, taskMemory, parallelDepth - 1);
+        });
+        copy->right = cloneSubtree(node->right, memory, parallelDepth - 1);
+        copy->left = left.get();
+    }
+    else {
+        copy->left = cloneSubtree(node->left, memory, 0);
+        copy->right = cloneSubtree(node->right, memory, 0);
+    }
+    copy->height = node->height;
+    copy->size = node->size;
+    return copy;
+}
+
+/**
+ * @brief Joins two AVL subtrees around a middle node.
+ *
+ * Every ID in left must be smaller than middle's, and every ID in right 
+ * larger. Walks down the spine of the taller tree until the heights are 
+ * within one, hangs the shorter tree there, and rebalances on the way back 
+ * up. Runs in O(|height(left) - height(right)| + 1).
+ *
+ * @param left Subtree of smaller IDs (may be null).
+ * @param middle Detached node to place between them.
+ * @param right Subtree of larger IDs (may be null).
+ * @return Root of the joined tree.
+ */
+Node* BinarySearchTree::join(Node* left, Node* middle, Node* right) {
+    if (height(left) > height(right) + 1) {
+        left->right = join(left->right, middle, right);
+        return rebalance(left);
+    }
+    if (height(right) > height(left) + 1) {
+        right->left = join(left, middle, right->left);
+        return rebalance(right);
+    }
+    middle->left = left;
+    middle->right = right;
+    updateNode(middle);
+    return middle;
+}
+
+/**
+ * @brief Joins two AVL subtrees when there is no middle node.
+ *
+ * Detaches the smallest node of right and uses it as the middle.
+ *
+ * @param left Subtree of smaller IDs (may be null).
+ * @param right Subtree of larger IDs (may be null).
+ * @return Root of the joined tree.
+ */
+Node* BinarySearchTree::joinPair(Node* left, Node* right) {
+    if (!right) {
+        return left;
+    }
+
+    Node* minimum = nullptr;
+    Node* rest = detachMin(right, minimum);
+    return join(left, minimum, rest);
+}
+
+/**
+ * @brief Detaches the smallest node of a subtree.
+ *
+ * @param node Root of the subtree; must not be null (recursive).
+ * @param minimum Set to the detached node.
+ * @return Root of the remaining subtree.
+ */
+Node* BinarySearchTree::detachMin(Node* node, Node*& minimum) {
+    if (!node->left) {
+        minimum = node;
+        return node->right;
+    }
+    node->left = detachMin(node->left, minimum);
+    return rebalance(node);
+}
+
+/**
+ * @brief Splits a subtree into the IDs below and above a key.
+ *
+ * Each node on the search path is joined onto one side or the other, so a 
+ * split costs O(log n).
+ *
+ * @param node Root of the subtree to split (recursive).
+ * @param key Packed ID to split at.
+ * @param courseId The ID to split at.
+ * @param less Set to the subtree of smaller IDs.
+ * @param greater Set to the subtree of larger IDs.
+ * @return The detached node with exactly that ID, or nullptr.
+ */
+Node* BinarySearchTree::split(Node* node, const CourseKey& key, string_view courseId, Node*& less, Node*& greater) {
+    if (!node) {
+        less = greater = nullptr;
+        return nullptr;
+    }
+
+    Node* left = node->left;
+    Node* right = node->right;
+    int order = compareCourseKeys(node->key, node->course, key, courseId);
+
+    if (order == 0) {
+        less = left;
+        greater = right;
+        return node;
+    }
+    if (order > 0) {
+        Node* found = split(left, key, courseId, less, left);
+        greater = join(left, node, right);
+        return found;
+    }
+    Node* found = split(right, key, courseId, right, greater);
+    less = join(left, node, right);
+    return found;
+}
+
+/**
+ * @brief Merges two subtrees, keeping a's course when both have an ID.
+ *
+ * Splits b around a's root, merges the halves on each side (in parallel 
+ * for large inputs), and joins the results back together around a's root. 
+ * Nodes of b that lose to a duplicate are left in the arena.
+ *
+ * @param a First subtree, owned by this tree (recursive).
+ * @param b Second subtree, owned by this tree.
+ * @param parallelDepth Remaining levels at which to fork a task.
+ * @return Root of the merged subtree.
+ */
+Node* BinarySearchTree::unionNodes(Node* a, Node* b, int parallelDepth) {
+    if (!a) {
+        return b;
+    }
+    if (!b) {
+        return a;
+    }
+
+    Node* lessB;
+    Node* greaterB;
+    split(b, a->key, a->course.courseId, lessB, greaterB);
+
+    Node* left;
+    Node* right;
+    if (parallelDepth > 0 && a->size + size(lessB) + size(greaterB) >= PARALLEL_TREE_GRAIN) {
+        future<Node*> leftTask = async(launch::async, [this, a, lessB, parallelDepth]() {
+            return unionNodes(a->left, lessB, parallelDepth - 1);
+        });
+        right = unionNodes(a->right, greaterB, parallelDepth - 1);
+        left = leftTask.get();
+    }
+    else {
+        left = unionNodes(a->left, lessB, 0);
+        right = unionNodes(a->right, greaterB, 0);
+    }
+    return join(left, a, right);
+}
+
+/**
+ * @brief Keeps the nodes of a whose ID is also in b.
+ *
+ * @param a First subtree, owned by this tree (recursive).
+ * @param b Second subtree, owned by this tree.
+ * @param parallelDepth Remaining levels at which to fork a task.
+ * @return Root of the intersection.
+ */
+Node* BinarySearchTree::intersectNodes(Node* a, Node* b, int parallelDepth) {
+    if (!a || !b) {
+        return nullptr;
+    }
+
+    Node* lessB;
+    Node* greaterB;
+    Node* found = split(b, a->key, a->course.courseId, lessB, greaterB);
+
+    Node* left;
+    Node* right;
+    if (parallelDepth > 0 && a->size + size(lessB) + size(greaterB) >= PARALLEL_TREE_GRAIN) {
+        future<Node*> leftTask = async(launch::async, [this, a, lessB, parallelDepth]() {
+            return intersectNodes(a->left, lessB, parallelDepth - 1);
+        });
+        right = intersectNodes(a->right, greaterB, parallelDepth - 1);
+        left = leftTask.get();
+    }
+    else {
+        left = intersectNodes(a->left, lessB, 0);
+        right = intersectNodes(a->right, greaterB, 0);
+    }
+    return found ? join(left, a, right) : joinPair(left, right);
+}
+
+/**
+ * @brief Keeps the nodes of a whose ID is not in b.
+ *
+ * Splits a around b's root, so the recursion follows b's shape.
+ *
+ * @param a First subtree, owned by this tree (recursive).
+ * @param b Second subtree, owned by this tree.
+ * @param parallelDepth Remaining levels at which to fork a task.
+ * @return Root of the difference.
+ */
+Node* BinarySearchTree::subtractNodes(Node* a, Node* b, int parallelDepth) {
+    if (!a || !b) {
+        return a;
+    }
+
+    Node* lessA;
+    Node* greaterA;
+    split(a, b->key, b->course.courseId, lessA, greaterA);
+
+    Node* left;
+    Node* right;
+    if (parallelDepth > 0 && b->size + size(lessA) + size(greaterA) >= PARALLEL_TREE_GRAIN) {
+        future<Node*> leftTask = async(launch::async, [this, b, lessA, parallelDepth]() {
+            return subtractNodes(lessA, b->left, parallelDepth - 1);
+        });
+        right = subtractNodes(greaterA, b->right, parallelDepth - 1);
+        left = leftTask.get();
+    }
+    else {
+        left = subtractNodes(lessA, b->left, 0);
+        right = subtractNodes(greaterA, b->right, 0);
+    }
+    return joinPair(left, right);
+}
+
+/**
+ * @brief Keeps the nodes of b whose ID is in a with a different name or prerequisites.
+ *
+ * @param a Subtree of the earlier catalog, owned by this tree (recursive).
+ * @param b Subtree of the later catalog, owned by this tree.
+ * @param parallelDepth Remaining levels at which to fork a task.
+ * @return Root of the changed courses, taken from b.
+ */
+Node* BinarySearchTree::changedNodes(Node* a, Node* b, int parallelDepth) {
+    if (!a || !b) {
+        return nullptr;
+    }
+
+    Node* lessA;
+    Node* greaterA;
+    Node* found = split(a, b->key, b->course.courseId, lessA, greaterA);
+
+    Node* left;
+    Node* right;
+    if (parallelDepth > 0 && b->size + size(lessA) + size(greaterA) >= PARALLEL_TREE_GRAIN) {
+        future<Node*> leftTask = async(launch::async, [this, b, lessA, parallelDepth]() {
+            return changedNodes(lessA, b->left, parallelDepth - 1);
+        });
+        right = changedNodes(greaterA, b->right, parallelDepth - 1);
+        left = leftTask.get();
+    }
+    else {
+        left = changedNodes(lessA, b->left, 0);
+        right = changedNodes(greaterA, b->right, 0);
+    }
+
+    bool changed = found && (found->course.name != b->course.name ||
+                             found->course.prerequisites != b->course.prerequisites);
+    return changed ? join(left, b, right) : joinPair(left, right);
+}
+
+/**
+ * @brief Rebuilds the hash index from the nodes reachable from the root.
+ */
+void BinarySearchTree::reindex() {
+    index.Clear();
+    index.Reserve(size(root));
+    VisitInOrder([this](const Course& course) {
+        index.Insert(&course);
+    });
+}
+
+/**
+ * @brief Runs a join-based set operation on copies of two trees.
+ *
+ * Both inputs are copied (in parallel) into a new arena-backed tree, since 
+ * split and join relink nodes in place; the operation then rearranges the 
+ * copies without allocating.
+ *
+ * @param a First tree.
+ * @param b Second tree.
+ * @param operation Member function combining the two copied roots.
+ * @return A new tree holding the result.
+ * @throws logic_error if either tree uses the B-tree backend.
+ */
+template <typename Operation>
+unique_ptr<BinarySearchTree> BinarySearchTree::combine(const BinarySearchTree& a, const BinarySearchTree& b,
+                                                       Operation operation) {
+    a.requireAVL("Set operations");
+    b.requireAVL("Set operations");
+
+    int parallelDepth = 0;
+    while ((1u << parallelDepth) < thread::hardware_concurrency()) {
+        ++parallelDepth;
+    }
+
+    unique_ptr<BinarySearchTree> result = make_unique<BinarySearchTree>();
+    Node* copyA = result->cloneSubtree(a.root, result->resource, parallelDepth);
+    Node* copyB = result->cloneSubtree(b.root, result->createTaskArena(), parallelDepth);
+
+    result->root = ((*result).*operation)(copyA, copyB, parallelDepth);
+    result->reindex();
+    return result;
+}
+
+/**
+ * @brief Rejects operations that only the AVL backend supports.
+ *
+ * @param operation Name of the operation, for the error message.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+void BinarySearchTree::requireAVL(const char* operation) const {
+    if (btree) {
+        throw logic_error(string(operation) + " requires the AVL backend.");
+    }
+}
+
+/**
+ * @brief Passes courses to a visitor in ascending order, starting at an ID.
+ *
+ * Seeks to the first course not less than courseId in O(log n) and then 
+ * walks forward until the visitor asks to stop.
+ *
+ * @param courseId Smallest course ID to visit.
+ * @param visit Callable taking a const Course& and returning false to stop.
+ */
+template <typename Visitor>
+void BinarySearchTree::scanFrom(string_view courseId, Visitor&& visit) const {
+    if (btree) {
+        btree->VisitFrom(courseId, visit);
+        return;
+    }
+    for (const_iterator it = lower_bound(courseId), last = end(); it != last; ++it) {
+        if (!visit(*it)) {
+            return;
+        }
+    }
+}
+
+/**
+ * @brief Returns an iterator to the course at a position in ID order.
+ *
+ * Descends once from the root, using subtree sizes to choose a side.
+ *
+ * @param position Zero-based position of the course.
+ * @return Iterator to the course, or end() if position >= Size().
+ */
+BinarySearchTree::const_iterator BinarySearchTree::seek(size_t position) const {
+    const_iterator it(root);
+    const Node* node = root;
+
+    while (node) {
+        it.push(node);
+        size_t leftSize = size(node->left);
+        if (position < leftSize) {
+            node = node->left;
+        }
+        else if (position == leftSize) {
+            return it;
+        }
+        else {
+            position -= leftSize + 1;
+            node = node->right;
+        }
+    }
+    it.depth = 0;
+    return it;
+}
+
+//============================================================================
+// Public Class Methods
+//============================================================================
+
+/**
+ * @brief Prints the entire tree in in-order sequence.
+ *
+ * Visits courses in ascending order of course ID.
+ */
+void BinarySearchTree::InOrder() {
+    VisitInOrder([](const Course& course) {
+        cout << course.courseId << ", " << course.name << endl;
+    });
+}
+
+/**
+ * @brief Prints the entire tree in post-order sequence.
+ *
+ * Visits left and right subtrees before each course.
+ */
+void BinarySearchTree::PostOrder() {
+    VisitPostOrder([](const Course& course) {
+        cout << course.courseId << ", " << course.name << endl;
+    });
+}
+
+/**
+ * @brief Prints the entire tree in pre-order sequence.
+ *
+ * Visits each course before its left and right subtrees.
+ */
+void BinarySearchTree::PreOrder() {
+    VisitPreOrder([](const Course& course) {
+        cout << course.courseId << ", " << course.name << endl;
+    });
+}
+
+/**
+ * @brief Passes every course to a visitor in ascending order of course ID.
+ *
+ * Walks the tree with a fixed-size stack instead of recursion, so the 
+ * traversal never allocates. Works with both backends.
+ *
+ * @param visit Callable taking a const Course&.
+ */
+template <typename Visitor>
+void BinarySearchTree::VisitInOrder(Visitor&& visit) const {
+    if (btree) {
+        btree->VisitInOrder(visit);
+        return;
+    }
+
+    const Node* pending[MAX_DEPTH];
+    int depth = 0;
+    const Node* node = root;
+
+    while (node || depth > 0) {
+        // Stack the left spine, then visit the smallest pending node
+        while (node) {
+            pending[depth++] = node;
+            node = node->left;
+        }
+        node = pending[--depth];
+        visit(node->course);
+        node = node->right;
+    }
+}
+
+/**
+ * @brief Passes every course to a visitor in pre-order.
+ *
+ * The stack holds at most one pending right subtree per level.
+ *
+ * @param visit Callable taking a const Course&.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+template <typename Visitor>
+void BinarySearchTree::VisitPreOrder(Visitor&& visit) const {
+    requireAVL("VisitPreOrder");
+
+    const Node* pending[MAX_DEPTH];
+    int depth = 0;
+    const Node* node = root;
+
+    while (node) {
+        visit(node->course);
+        if (node->right) {
+            pending[depth++] = node->right;
+        }
+        if (node->left) {
+            node = node->left;
+        }
+        else {
+            node = depth > 0 ? pending[--depth] : nullptr;
+        }
+    }
+}
+
+/**
+ * @brief Passes every course to a visitor in post-order.
+ *
+ * A node is visited once the walk comes back up from its right subtree, 
+ * which is detected by remembering the last node visited.
+ *
+ * @param visit Callable taking a const Course&.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+template <typename Visitor>
+void BinarySearchTree::VisitPostOrder(Visitor&& visit) const {
+    requireAVL("VisitPostOrder");
+
+    const Node* pending[MAX_DEPTH];
+    int depth = 0;
+    const Node* node = root;
+    const Node* visited = nullptr;
+
+    while (node || depth > 0) {
+        while (node) {
+            pending[depth++] = node;
+            node = node->left;
+        }
+
+        const Node* top = pending[depth - 1];
+        if (top->right && top->right != visited) {
+            node = top->right;
+        }
+        else {
+            visit(top->course);
+            visited = top;
+            --depth;
+        }
+    }
+}
+
+/**
+ * @brief Returns an iterator to the course with the smallest ID.
+ *
+ * @return Iterator to the first course, or end() if the tree is empty.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+BinarySearchTree::const_iterator BinarySearchTree::begin() const {
+    requireAVL("begin");
+
+    const_iterator it(root);
+    it.descendLeft(root);
+    return it;
+}
+
+/**
+ * @brief Returns the past-the-end iterator.
+ *
+ * @return Iterator one past the last course.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+BinarySearchTree::const_iterator BinarySearchTree::end() const {
+    requireAVL("end");
+    return const_iterator(root);
+}
+
+/**
+ * @brief Returns an iterator to the first course whose ID is not less than courseId.
+ *
+ * @param courseId The course ID to seek to.
+ * @return Iterator to the course, or end() if every ID is smaller.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+BinarySearchTree::const_iterator BinarySearchTree::lower_bound(string_view courseId) const {
+    requireAVL("lower_bound");
+
+    CourseKey key = CourseKey::Pack(courseId);
+    const_iterator it(root);
+    int found = 0;
+    const Node* node = root;
+
+    // Keep the whole path, then cut it back to the last node that was >= key
+    while (node) {
+        it.push(node);
+        if (compareCourseKeys(node->key, node->course, key, courseId) >= 0) {
+            found = it.depth;
+            node = node->left;
+        }
+        else {
+            node = node->right;
+        }
+    }
+    it.depth = found;
+    return it;
+}
+
+/**
+ * @brief Returns the courses in either tree.
+ *
+ * When both trees have an ID, the course from a is kept. The merge is 
+ * join-based: O(m log(n/m + 1)) work for trees of sizes m <= n, with the 
+ * two halves of every large subproblem run in parallel, on top of the 
+ * linear cost of copying the inputs into the new tree.
+ *
+ * @param a First tree.
+ * @param b Second tree.
+ * @return A new tree holding the union.
+ * @throws logic_error if either tree uses the B-tree backend.
+ */
+unique_ptr<BinarySearchTree> BinarySearchTree::Union(const BinarySearchTree& a, const BinarySearchTree& b) {
+    return combine(a, b, &BinarySearchTree::unionNodes);
+}
+
+/**
+ * @brief Returns the courses of a whose ID is also in b.
+ *
+ * @param a First tree.
+ * @param b Second tree.
+ * @return A new tree holding the intersection, with the courses from a.
+ * @throws logic_error if either tree uses the B-tree backend.
+ */
+unique_ptr<BinarySearchTree> BinarySearchTree::Intersection(const BinarySearchTree& a, const BinarySearchTree& b) {
+    return combine(a, b, &BinarySearchTree::intersectNodes);
+}
+
+/**
+ * @brief Returns the courses of a whose ID is not in b.
+ *
+ * @param a First tree.
+ * @param b Second tree.
+ * @return A new tree holding a minus b.
+ * @throws logic_error if either tree uses the B-tree backend.
+ */
+unique_ptr<BinarySearchTree> BinarySearchTree::Difference(const BinarySearchTree& a, const BinarySearchTree& b) {
+    return combine(a, b, &BinarySearchTree::subtractNodes);
+}
+
+/**
+ * @brief Returns the courses present in both catalogs whose details changed.
+ *
+ * A course counts as changed when its name or prerequisites differ. Added 
+ * and dropped courses are Difference(after, before) and 
+ * Difference(before, after).
+ *
+ * @param before The earlier catalog.
+ * @param after The later catalog.
+ * @return A new tree holding the changed courses as they are in after.
+ * @throws logic_error if either tree uses the B-tree backend.
+ */
+unique_ptr<BinarySearchTree> BinarySearchTree::Diff(const BinarySearchTree& before, const BinarySearchTree& after) {
+    return combine(before, after, &BinarySearchTree::changedNodes);
+}
+
+/**
+ * @brief Inserts a course into the tree.
+ *
+ * Throws a DuplicateCourseException if the course ID already exists. The 
+ * duplicate check is a single hash index probe rather than a tree search.
+ *
+ * @param course The course to insert.
+ * @throws DuplicateCourseException if the course ID is already in the tree.
+ */
+void BinarySearchTree::Insert(Course course) {
+    if (index.Find(course.courseId)) {
+        throw DuplicateCourseException(course.courseId);
+    }
+
+    if (btree) {
+        index.Insert(btree->Insert(move(course)));
+    }
+    else {
+        Node* added = createNode(move(course));
+        insertNode(added);
+        index.Insert(&added->course);
+    }
+}
+
+/**
+ * @brief Loads many courses at once.
+ *
+ * When an AVL tree is empty, the courses are sorted and deduplicated once 
+ * and the tree is built bottom-up in linear time; for large inputs both 
+ * steps are split across threads. Otherwise each course goes through 
+ * Insert(). In both cases the first course with a given ID wins, just as 
+ * with repeated Insert() calls.
+ *
+ * @param courses The courses to load. Loaded courses are moved from; 
+ *                duplicates are left untouched.
+ * @param threads Most threads to use, or 0 for one per hardware thread.
+ * @return Positions of the courses rejected as duplicates, in input order.
+ */
+vector<size_t> BinarySearchTree::BulkLoad(vector<Course>& courses, unsigned threads) {
+    vector<size_t> duplicates;
+
+    if (threads == 0) {
+        threads = thread::hardware_concurrency();
+    }
+
+    if (btree || root) {
+        for (size_t row = 0; row < courses.size(); ++row) {
+            if (index.Find(courses[row].courseId)) {
+                duplicates.push_back(row);
+            }
+            else {
+                Insert(move(courses[row]));
+            }
+        }
+        return duplicates;
+    }
+
+    struct Entry {
+        CourseKey key;
+        size_t row;
+    };
+
+    vector<Entry> entries(courses.size());
+    for (size_t row = 0; row < courses.size(); ++row) {
+        entries[row] = Entry{ CourseKey::Pack(courses[row].courseId), row };
+    }
+
+    // Sort by ID, keeping equal IDs in input order
+    parallelSort(entries, [&courses](const Entry& a, const Entry& b) {
+        int order = compareCourseKeys(a.key, courses[a.row], b.key, courses[b.row].courseId);
+        return order != 0 ? order < 0 : a.row < b.row;
+    }, threads);
+
+    // The first entry of each run of equal IDs is kept
+    vector<size_t> rows;
+    rows.reserve(entries.size());
+    for (size_t i = 0; i < entries.size(); ++i) {
+        const Entry& entry = entries[i];
+        if (!rows.empty() &&
+            matchesCourseKey(CourseKey::Pack(courses[rows.back()].courseId), courses[rows.back()],
+                             entry.key, courses[entry.row].courseId)) {
+            duplicates.push_back(entry.row);
+        }
+        else {
+            rows.push_back(entry.row);
+        }
+    }
+    sort(duplicates.begin(), duplicates.end());
+
+    root = buildParallel(courses, rows, threads);
+    reindex();
+    return duplicates;
+}
+
+/**
+ * @brief Removes a course from the tree.
+ *
+ * @param courseId The ID of the course to remove.
+ */
+void BinarySearchTree::Remove(string_view courseId) {
+    // Unknown IDs are rejected without walking the tree
+    if (!index.Erase(courseId)) {
+        return;
+    }
+
+    if (btree) {
+        btree->Remove(courseId);
+    }
+    else {
+        removeNode(CourseKey::Pack(courseId), courseId);
+    }
+}
+
+/**
+ * @brief Searches for a course in the tree and returns a copy of it.
+ *
+ * Prefer Find() when the caller only needs to read the course.
+ *
+ * @param courseId The ID of the course to search for.
+ * @return The course if found, or an empty Course object if not.
+ */
+Course BinarySearchTree::Search(string_view courseId) const {
+    const Course* result = Find(courseId);
+    return result ? *result : Course();
+}
+
+/**
+ * @brief Looks up a course without copying it.
+ *
+ * Point lookups go through the hash index in O(1) expected time and do 
+ * not allocate. The returned pointer is owned by the tree and stays valid 
+ * until the next Insert(), Remove() or Clear().
+ *
+ * @param courseId The ID of the course to look for.
+ * @return Pointer to the stored course, or nullptr if not found.
+ */
+const Course* BinarySearchTree::Find(string_view courseId) const {
+    return index.Find(courseId);
+}
+
+/**
+ * @brief Checks whether a course is in the tree without copying it.
+ *
+ * @param courseId The ID of the course to look for.
+ * @return True if the course exists.
+ */
+bool BinarySearchTree::Contains(string_view courseId) const {
+    return index.Find(courseId) != nullptr;
+}
+
+/**
+ * @brief Returns the allocator the tree stores course text with.
+ *
+ * Courses built with this allocator are moved into the tree on Insert() 
+ * and single-threaded BulkLoad() without their strings being copied again.
+ *
+ * @return Allocator over the tree's arena (or heap).
+ */
+Course::allocator_type BinarySearchTree::Allocator() const {
+    return Course::allocator_type(resource);
+}
+
+/**
+ * @brief Removes every course from the tree.
+ *
+ * An arena-backed tree releases all of its slabs at once without visiting 
+ * the nodes. A heap-backed tree destroys its nodes one by one.
+ */
+void BinarySearchTree::Clear() {
+    if (btree) {
+        btree->Abandon();
+    }
+    index.Clear();
+    taskArenas.clear();
+    if (arena) {
+        arena->release();
+    }
+    else {
+        vector<Node*> pending;
+        if (root) {
+            pending.push_back(root);
+        }
+        while (!pending.empty()) {
+            Node* node = pending.back();
+            pending.pop_back();
+            if (node->left) {
+                pending.push_back(node->left);
+            }
+            if (node->right) {
+                pending.push_back(node->right);
+            }
+            destroyNode(node);
+        }
+    }
+    root = nullptr;
+    freeSlots = nullptr;
+}
+
+/**
+ * @brief Returns the number of courses in the tree.
+ *
+ * @return Number of courses.
+ */
+size_t BinarySearchTree::Size() const {
+    return index.Size();
+}
+
+/**
+ * @brief Returns the number of courses whose ID is less than courseId.
+ *
+ * This is the position courseId has, or would have, in ID order. Runs in 
+ * O(log n) using the subtree sizes.
+ *
+ * @param courseId The course ID to rank.
+ * @return Number of smaller course IDs.
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+size_t BinarySearchTree::Rank(string_view courseId) const {
+    requireAVL("Rank");
+
+    CourseKey key = CourseKey::Pack(courseId);
+    size_t rank = 0;
+    const Node* node = root;
+
+    while (node) {
+        if (compareCourseKeys(node->key, node->course, key, courseId) >= 0) {
+            node = node->left;
+        }
+        else {
+            rank += size(node->left) + 1;
+            node = node->right;
+        }
+    }
+    return rank;
+}
+
+/**
+ * @brief Returns the course at a position in ID order.
+ *
+ * @param position Zero-based position of the course.
+ * @return Pointer to the course, or nullptr if position >= Size().
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+const Course* BinarySearchTree::Select(size_t position) const {
+    requireAVL("Select");
+
+    const_iterator it = seek(position);
+    return it == end() ? nullptr : &*it;
+}
+
+/**
+ * @brief Passes one page of courses, in ID order, to a visitor.
+ *
+ * Seeks straight to the first course of the page in O(log n) instead of 
+ * walking the preceding pages.
+ *
+ * @param page Zero-based page number.
+ * @param pageSize Number of courses per page.
+ * @param visit Callable taking a const Course&.
+ * @return Number of courses visited (less than pageSize on the last page).
+ * @throws logic_error if the tree uses the B-tree backend.
+ */
+template <typename Visitor>
+size_t BinarySearchTree::VisitPage(size_t page, size_t pageSize, Visitor&& visit) const {
+    requireAVL("VisitPage");
+
+    size_t count = 0;
+    if (pageSize == 0 || page > Size() / pageSize) {
+        return count;
+    }
+    for (const_iterator it = seek(page * pageSize), last = end(); it != last && count < pageSize; ++it) {
+        visit(*it);
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Passes every course with an ID in [first, last] to a visitor.
+ *
+ * Subtrees outside the range are never entered, so a scan costs 
+ * O(log n + k) for k matching courses. Works with both backends.
+ *
+ * @param first Smallest course ID to include.
+ * @param last Largest course ID to include.
+ * @param visit Callable taking a const Course&.
+ * @return Number of courses visited.
+ */
+template <typename Visitor>
+size_t BinarySearchTree::RangeScan(string_view first, string_view last, Visitor&& visit) const {
+    size_t count = 0;
+
+    scanFrom(first, [&](const Course& course) {
+        if (string_view(course.courseId) > last) {
+            return false;
+        }
+        visit(course);
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+/**
+ * @brief Passes every course whose ID starts with a prefix to a visitor.
+ *
+ * Matching IDs are contiguous in ID order, so this is a range scan that 
+ * starts at the prefix itself and stops at the first ID without it.
+ *
+ * @param prefix The leading characters to match (e.g. "CSCI3").
+ * @param visit Callable taking a const Course&.
+ * @return Number of courses visited.
+ */
+template <typename Visitor>
+size_t BinarySearchTree::PrefixScan(string_view prefix, Visitor&& visit) const {
+    size_t count = 0;
+
+    scanFrom(prefix, [&](const Course& course) {
+        if (string_view(course.courseId).substr(0, prefix.size()) != prefix) {
+            return false;
+        }
+        visit(course);
+        ++count;
+        return true;
+    });
+    return count;
+}
+
+//============================================================================
+// Iterator Methods
+//============================================================================
+
+/**
+ * @brief Constructs an iterator that is not attached to any tree.
+ */
+BinarySearchTree::const_iterator::const_iterator() : const_iterator(nullptr) {
+}
+
+/**
+ * @brief Constructs the end iterator of the tree with the given root.
+ *
+ * @param root Root of the tree to iterate.
+ */
+BinarySearchTree::const_iterator::const_iterator(const Node* root) {
+    this->root = root;
+    depth = 0;
+}
+
+/**
+ * @brief Appends a node to the current path.
+ *
+ * @param node The child of the current node to move to.
+ */
+void BinarySearchTree::const_iterator::push(const Node* node) {
+    path[depth++] = node;
+}
+
+/**
+ * @brief Moves to the smallest course of a subtree.
+ *
+ * @param node Root of the subtree.
+ */
+void BinarySearchTree::const_iterator::descendLeft(const Node* node) {
+    for (; node; node = node->left) {
+        push(node);
+    }
+}
+
+/**
+ * @brief Moves to the largest course of a subtree.
+ *
+ * @param node Root of the subtree.
+ */
+void BinarySearchTree::const_iterator::descendRight(const Node* node) {
+    for (; node; node = node->right) {
+        push(node);
+    }
+}
+
+/**
+ * @brief Returns the current course.
+ */
+const Course& BinarySearchTree::const_iterator::operator*() const {
+    return path[depth - 1]->course;
+}
+
+/**
+ * @brief Returns a pointer to the current course.
+ */
+const Course* BinarySearchTree::const_iterator::operator->() const {
+    return &path[depth - 1]->course;
+}
+
+/**
+ * @brief Advances to the next course in ID order.
+ *
+ * Descends into the right subtree if there is one; otherwise climbs until 
+ * the path leaves a left child, whose parent is the successor.
+ *
+ * @return This iterator.
+ */
+BinarySearchTree::const_iterator& BinarySearchTree::const_iterator::operator++() {
+    const Node* node = path[depth - 1];
+
+    if (node->right) {
+        descendLeft(node->right);
+        return *this;
+    }
+    do {
+        node = path[--depth];
+    } while (depth > 0 && path[depth - 1]->right == node);
+    return *this;
+}
+
+/**
+ * @brief Advances to the next course, returning the previous position.
+ */
+BinarySearchTree::const_iterator BinarySearchTree::const_iterator::operator++(int) {
+    const_iterator previous = *this;
+    ++*this;
+    return previous;
+}
+
+/**
+ * @brief Steps back to the previous course in ID order.
+ *
+ * Mirrors operator++(). Decrementing end() moves to the largest course.
+ *
+ * @return This iterator.
+ */
+BinarySearchTree::const_iterator& BinarySearchTree::const_iterator::operator--() {
+    if (depth == 0) {
+        descendRight(root);
+        return *this;
+    }
+
+    const Node* node = path[depth - 1];
+
+    if (node->left) {
+        descendRight(node->left);
+        return *this;
+    }
+    do {
+        node = path[--depth];
+    } while (depth > 0 && path[depth - 1]->left == node);
+    return *this;
+}
+
+/**
+ * @brief Steps back to the previous course, returning the previous position.
+ */
+BinarySearchTree::const_iterator BinarySearchTree::const_iterator::operator--(int) {
+    const_iterator previous = *this;
+    --*this;
+    return previous;
+}
+
+/**
+ * @brief Checks whether two iterators point at the same course.
+ *
+ * @param other Iterator over the same tree.
+ * @return True if both are at the same node, or both are at the end.
+ */
+bool BinarySearchTree::const_iterator::operator==(const const_iterator& other) const {
+    if (depth == 0 || other.depth == 0) {
+        return depth == other.depth;
+    }
+    return path[depth - 1] == other.path[other.depth - 1];
+}
+
+/**
+ * @brief Checks whether two iterators point at different courses.
+ */
+bool BinarySearchTree::const_iterator::operator!=(const const_iterator& other) const {
+    return !(*this == other);
+}
+
+//============================================================================
+// Shared Catalog
+//============================================================================
+
+/**
+ * @class SharedCatalog
+ * @brief Publishes a read-only BinarySearchTree to many reader threads.
+ *
+ * Readers never take a lock: a read announces the current epoch in the 
+ * reader's own slot, loads the published tree pointer, and clears the slot 
+ * when done. A reload builds a complete new tree off to the side and 
+ * publishes it with a single atomic pointer swap, so readers see either the 
+ * old catalog or the new one, never a mix.
+ *
+ * Replaced trees are retired with the epoch at which they were swapped out 
+ * and deleted once every active reader has announced a later epoch. A 
+ * published tree must not be modified; only Publish() changes what readers 
+ * see.
+ */
+class SharedCatalog {
+
+    public:
+        static constexpr int MAX_READERS = 64;  /// Reader slots available
+
+    private:
+        /// Per-reader announcement, padded so readers do not share cache lines.
+        struct alignas(64) ReaderSlot {
+            atomic<uint64_t> epoch;     /// Epoch of the read in progress, or IDLE
+            atomic<bool> claimed;       /// True while a Reader owns the slot
+        };
+
+        /// A replaced tree waiting for the readers that might still see it.
+        struct RetiredTree {
+            uint64_t epoch;             /// First epoch whose readers cannot see it
+            unique_ptr<const BinarySearchTree> tree;
+        };
+
+        static constexpr uint64_t IDLE = 0;
+
+        ReaderSlot slots[MAX_READERS];
+        atomic<const BinarySearchTree*> current;
+        atomic<uint64_t> epoch;
+        mutex writerMutex;              /// Serializes Publish() and Reclaim()
+        vector<RetiredTree> retired;
+
+        uint64_t oldestActiveEpoch() const;
+        size_t reclaim();
+
+    public:
+        class Reader;
+
+        SharedCatalog();
+        ~SharedCatalog();
+
+        // Publishing is the only way to share a tree, so copying is disabled.
+        SharedCatalog(const SharedCatalog&) = delete;
+        SharedCatalog& operator=(const SharedCatalog&) = delete;
+
+        void Publish(unique_ptr<BinarySearchTree> tree);
+        size_t Reclaim();
+        size_t RetiredCount();
+};
+
+/**
+ * @class SharedCatalog::Reader
+ * @brief A thread's handle for lock-free reads of a SharedCatalog.
+ *
+ * Claims one reader slot for its lifetime. Each thread should own its own 
+ * Reader; a Reader must not be used by two threads at once.
+ */
+class SharedCatalog::Reader {
+
+    private:
+        SharedCatalog& catalog;
+        ReaderSlot* slot;
+
+    public:
+        explicit Reader(SharedCatalog& catalog);
+        ~Reader();
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+
+        template <typename Function>
+        auto Read(Function&& read);
+};
+
+/**
+ * @brief Constructs a catalog that publishes an empty tree.
+ */
+SharedCatalog::SharedCatalog() {
+    for (ReaderSlot& slot : slots) {
+        slot.epoch.store(IDLE);
+        slot.claimed.store(false);
+    }
+    current.store(new BinarySearchTree());
+    epoch.store(1);
+}
+
+/**
+ * @brief Destroys the published tree and every retired tree.
+ *
+ * No Reader may outlive the catalog.
+ */
+SharedCatalog::~SharedCatalog() {
+    delete current.load();
+}
+
+/**
+ * @brief Returns the oldest epoch announced by a reader that is mid-read.
+ *
+ * @return The oldest announced epoch, or UINT64_MAX if no read is active.
+ */
+uint64_t SharedCatalog::oldestActiveEpoch() const {
+    uint64_t oldest = UINT64_MAX;
+
+    for (const ReaderSlot& slot : slots) {
+        uint64_t announced = slot.epoch.load();
+        if (announced != IDLE) {
+            oldest = min(oldest, announced);
+        }
+    }
+    return oldest;
+}
+
+/**
+ * @brief Deletes the retired trees that no active reader can still see.
+ *
+ * The caller must hold writerMutex.
+ *
+ * @return Number of trees deleted.
+ */
+size_t SharedCatalog::reclaim() {
+    uint64_t oldest = oldestActiveEpoch();
+
+    auto firstKept = partition(retired.begin(), retired.end(), [oldest](const RetiredTree& entry) {
+        return entry.epoch > oldest;
+    });
+    size_t reclaimed = retired.end() - firstKept;
+    retired.erase(firstKept, retired.end());
+    return reclaimed;
+}
+
+/**
+ * @brief Makes a new tree visible to readers and retires the old one.
+ *
+ * The swap is a single atomic store, so reads that are already running 
+ * finish on the old tree and reads that start afterwards see the new one. 
+ * Retired trees that are no longer visible are deleted before returning.
+ *
+ * @param tree The fully built tree to publish. It must not be modified 
+ *             after this call.
+ */
+void SharedCatalog::Publish(unique_ptr<BinarySearchTree> tree) {
+    lock_guard<mutex> lock(writerMutex);
+
+    const BinarySearchTree* previous = current.exchange(tree.release());
+
+    // Readers that announce the new epoch started after the swap
+    uint64_t retiredAt = epoch.fetch_add(1) + 1;
+    retired.push_back(RetiredTree{ retiredAt, unique_ptr<const BinarySearchTree>(previous) });
+    reclaim();
+}
+
+/**
+ * @brief Deletes the retired trees that no active reader can still see.
+ *
+ * Publish() already does this; calling it separately only frees trees 
+ * that were still in use at the last Publish().
+ *
+ * @return Number of trees deleted.
+ */
+size_t SharedCatalog::Reclaim() {
+    lock_guard<mutex> lock(writerMutex);
+    return reclaim();
+}
+
+/**
+ * @brief Returns the number of replaced trees not yet deleted.
+ */
+size_t SharedCatalog::RetiredCount() {
+    lock_guard<mutex> lock(writerMutex);
+    return retired.size();
+}
+
+/**
+ * @brief Claims a free reader slot.
+ *
+ * @param catalog The catalog to read from.
+ * @throws runtime_error if all MAX_READERS slots are taken.
+ */
+SharedCatalog::Reader::Reader(SharedCatalog& catalog) : catalog(catalog) {
+    for (ReaderSlot& candidate : catalog.slots) {
+        bool expected = false;
+        if (candidate.claimed.compare_exchange_strong(expected, true)) {
+            slot = &candidate;
+            return;
+        }
+    }
+    throw runtime_error("Too many concurrent catalog readers.");
+}
+
+/**
+ * @brief Releases the reader slot.
+ */
+SharedCatalog::Reader::~Reader() {
+    slot->claimed.store(false);
+}
+
+/**
+ * @brief Runs a function against the currently published tree.
+ *
+ * The tree, and anything found in it, stays valid until the function 
+ * returns; results must be copied out rather than kept as pointers. 
+ * Takes no lock.
+ *
+ * @param read Callable taking a const BinarySearchTree&.
+ * @return Whatever read returns.
+ */
+template <typename Function>
+auto SharedCatalog::Reader::Read(Function&& read) {
+    // Announce the epoch before loading the pointer, so a writer that swaps 
+    // after this point keeps the tree loaded below alive.
+    slot->epoch.store(catalog.epoch.load());
+
+    struct Exit {
+        ReaderSlot* slot;
+        ~Exit() { slot->epoch.store(IDLE); }
+    } exit{ slot };
+
+    return read(*catalog.current.load());
+}
+
+//============================================================================
+// Sharded Catalog
+//============================================================================
+
+/**
+ * @class ShardedCatalog
+ * @brief Course catalog split across independently locked AVL trees.
+ *
+ * Each course lives in the shard chosen by the top bits of its packed-ID 
+ * hash, so courses spread evenly no matter how IDs cluster by department. 
+ * Every shard has its own reader-writer lock: Insert() and Remove() take 
+ * one shard's exclusive lock and lookups take one shard's shared lock, so 
+ * threads working on different shards never wait for each other.
+ *
+ * Ordered traversals lock every shard for reading and merge the shards' 
+ * in-order iterators, so the output is still globally sorted.
+ */
+class ShardedCatalog {
+
+    private:
+        /// One tree and its lock, padded so neighbouring locks do not share a cache line.
+        struct alignas(64) Shard {
+            mutable shared_mutex lock;
+            BinarySearchTree tree;
+        };
+
+        unique_ptr<Shard[]> shards;
+        size_t shardCount;
+        int shardBits;              /// log2(shardCount)
+
+        Shard& shardFor(string_view courseId) const;
+
+    public:
+        static constexpr size_t DEFAULT_SHARDS = 16;
+
+        explicit ShardedCatalog(size_t minimumShards = DEFAULT_SHARDS);
+
+        void Insert(Course course);
+        void Remove(string_view courseId);
+        Course Search(string_view courseId) const;
+        bool Contains(string_view courseId) const;
+        size_t Size() const;
+        size_t ShardCount() const;
+
+        template <typename Visitor>
+        void VisitInOrder(Visitor&& visit) const;
+        void InOrder() const;
+};
+
+/**
+ * @brief Constructs an empty catalog.
+ *
+ * @param minimumShards Number of shards wanted; rounded up to a power of two.
+ */
+ShardedCatalog::ShardedCatalog(size_t minimumShards) {
+    shardBits = 0;
+    while ((size_t(1) << shardBits) < minimumShards) {
+        ++shardBits;
+    }
+    shardCount = size_t(1) << shardBits;
+    shards = make_unique<Shard[]>(shardCount);
+}
+
+/**
+ * @brief Returns the shard that holds (or would hold) a course ID.
+ *
+ * Uses the high bits of the hash; the shard's own hash index uses the low 
+ * bits, so sharding does not crowd the index into a fraction of its slots.
+ *
+ * @param courseId The course ID.
+ * @return The owning shard.
+ */
+ShardedCatalog::Shard& ShardedCatalog::shardFor(string_view courseId) const {
+    if (shardBits == 0) {
+        return shards[0];
+    }
+    return shards[hashCourseKey(CourseKey::Pack(courseId)) >> (64 - shardBits)];
+}
+
+/**
+ * @brief Inserts a course. Safe to call from many threads at once.
+ *
+ * @param course The course to insert.
+ * @throws BinarySearchTree::DuplicateCourseException if the ID already exists.
+ */
+void ShardedCatalog::Insert(Course course) {
+    Shard& shard = shardFor(course.courseId);
+    unique_lock<shared_mutex> lock(shard.lock);
+    shard.tree.Insert(move(course));
+}
+
+/**
+ * @brief Removes a course if it exists. Safe to call from many threads at once.
+ *
+ * @param courseId The ID of the course to remove.
+ */
+void ShardedCatalog::Remove(string_view courseId) {
+    Shard& shard = shardFor(courseId);
+    unique_lock<shared_mutex> lock(shard.lock);
+    shard.tree.Remove(courseId);
+}
+
+/**
+ * @brief Returns a copy of a course.
+ *
+ * A copy is returned because a pointer into the shard could be invalidated 
+ * by another thread as soon as the shard lock is released.
+ *
+ * @param courseId The ID of the course to search for.
+ * @return The course if found, or an empty Course object if not.
+ */
+Course ShardedCatalog::Search(string_view courseId) const {
+    Shard& shard = shardFor(courseId);
+    shared_lock<shared_mutex> lock(shard.lock);
+    return shard.tree.Search(courseId);
+}
+
+/**
+ * @brief Checks whether a course exists.
+ *
+ * @param courseId The ID of the course to look for.
+ * @return True if the course is in the catalog.
+ */
+bool ShardedCatalog::Contains(string_view courseId) const {
+    Shard& shard = shardFor(courseId);
+    shared_lock<shared_mutex> lock(shard.lock);
+    return shard.tree.Contains(courseId);
+}
+
+/**
+ * @brief Returns the number of courses across all shards.
+ *
+ * Each shard is counted under its own lock, so concurrent updates may make 
+ * the total slightly stale.
+ */
+size_t ShardedCatalog::Size() const {
+    size_t total = 0;
+
+    for (size_t i = 0; i < shardCount; ++i) {
+        shared_lock<shared_mutex> lock(shards[i].lock);
+        total += shards[i].tree.Size();
+    }
+    return total;
+}
+
+/**
+ * @brief Returns the number of shards.
+ */
+size_t ShardedCatalog::ShardCount() const {
+    return shardCount;
+}
+
+/**
+ * @brief Passes every course to a visitor in ascending order of course ID.
+ *
+ * Locks all shards for reading (always in shard order, so two traversals 
+ * cannot deadlock) and performs a k-way merge of their in-order iterators 
+ * with a small min-heap. Iterators carry their whole descent path, so they 
+ * stay in place in a vector and the heap only moves shard indices. Writers 
+ * wait until the traversal finishes.
+ *
+ * @param visit Callable taking a const Course&.
+ */
+template <typename Visitor>
+void ShardedCatalog::VisitInOrder(Visitor&& visit) const {
+    vector<shared_lock<shared_mutex>> locks;
+    vector<BinarySearchTree::const_iterator> positions;
+    vector<BinarySearchTree::const_iterator> ends;
+    vector<size_t> heap;                    /// Shards with courses left
+    locks.reserve(shardCount);
+    positions.reserve(shardCount);
+    ends.reserve(shardCount);
+
+    for (size_t i = 0; i < shardCount; ++i) {
+        locks.emplace_back(shards[i].lock);
+        positions.push_back(shards[i].tree.begin());
+        ends.push_back(shards[i].tree.end());
+        if (shards[i].tree.Size() > 0) {
+            heap.push_back(i);
+        }
+    }
+
+    // Min-heap on each shard's current course ID
+    auto later = [&positions](size_t a, size_t b) {
+        return string_view(positions[a]->courseId) > string_view(positions[b]->courseId);
+    };
+    make_heap(heap.begin(), heap.end(), later);
+
+    while (!heap.empty()) {
+        pop_heap(heap.begin(), heap.end(), later);
+        size_t shard = heap.back();
+
+        visit(*positions[shard]);
+        if (++positions[shard] == ends[shard]) {
+            heap.pop_back();
+        }
+        else {
+            push_heap(heap.begin(), heap.end(), later);
+        }
+    }
+}
+
+/**
+ * @brief Prints every course in ascending order of course ID.
+ */
+void ShardedCatalog::InOrder() const {
+    VisitInOrder([](const Course& course) {
+        cout << course.courseId << ", " << course.name << endl;
+    });
+}
+
+//============================================================================
+// Persistent Catalog
+//============================================================================
+
+/**
+ * @class PersistentCatalog
+ * @brief Versioned AVL catalog whose snapshots share unchanged subtrees.
+ *
+ * Nodes are immutable and reference counted. Insert() and Remove() copy 
+ * only the O(log n) nodes on the path to the change (plus any rotated 
+ * nodes) and point the copies at the untouched subtrees of the old 
+ * version, so each edit costs O(log n) time and memory. A snapshot is just 
+ * another reference to the current root: Snapshot() is O(1), and a version 
+ * stays intact and searchable no matter what is done to later versions. 
+ * Courses themselves are shared between versions as well.
+ *
+ * Different versions may be read and edited from different threads; a 
+ * single version must not be edited while it is being read.
+ */
+class PersistentCatalog {
+
+    private:
+        struct PersistentNode;
+        using NodePtr = shared_ptr<const PersistentNode>;
+
+        struct PersistentNode {
+            CourseKey key;                      /// Packed course ID
+            shared_ptr<const Course> course;    /// Shared by every version containing it
+            NodePtr left;
+            NodePtr right;
+            int height;
+            size_t size;                        /// Number of nodes in this subtree
+        };
+
+        NodePtr root;
+
+        // Path-Copying Helper Methods
+        static int height(const NodePtr& node);
+        static size_t size(const NodePtr& node);
+        static NodePtr makeNode(const CourseKey& key, shared_ptr<const Course> course, NodePtr left, NodePtr right);
+        static NodePtr balance(const CourseKey& key, shared_ptr<const Course> course, NodePtr left, NodePtr right);
+        static NodePtr insertInto(const NodePtr& node, const CourseKey& key, shared_ptr<const Course> course);
+        static NodePtr removeMin(const NodePtr& node, NodePtr& minimum);
+        static NodePtr removeFrom(const NodePtr& node, const CourseKey& key, string_view courseId);
+        static NodePtr buildBalanced(const vector<shared_ptr<const Course>>& courses, size_t first, size_t last);
+
+    public:
+        PersistentCatalog();
+        explicit PersistentCatalog(const BinarySearchTree& tree);
+
+        PersistentCatalog Snapshot() const;
+
+        void Insert(Course course);
+        void Remove(string_view courseId);
+        const Course* Find(string_view courseId) const;
+        size_t Size() const;
+
+        template <typename Visitor>
+        void VisitInOrder(Visitor&& visit) const;
+
+        static size_t CountDistinctNodes(const vector<PersistentCatalog>& versions);
+};
+
+/**
+ * @brief Constructs an empty catalog.
+ */
+PersistentCatalog::PersistentCatalog() {
+}
+
+/**
+ * @brief Constructs a first version holding every course of a tree.
+ *
+ * The tree's in-order sequence is already sorted, so the version is built 
+ * bottom-up in O(n) without rotations.
+ *
+ * @param tree The tree to copy the courses from.
+ */
+PersistentCatalog::PersistentCatalog(const BinarySearchTree& tree) {
+    vector<shared_ptr<const Course>> courses;
+    courses.reserve(tree.Size());
+
+    tree.VisitInOrder([&courses](const Course& course) {
+        courses.push_back(make_shared<const Course>(course));
+    });
+    root = buildBalanced(courses, 0, courses.size());
+}
+
+/**
+ * @brief Returns the height of a node, or -1 if null.
+ */
+int PersistentCatalog::height(const NodePtr& node) {
+    return node ? node->height : -1;
+}
+
+/**
+ * @brief Returns the size of a subtree, or 0 if null.
+ */
+size_t PersistentCatalog::size(const NodePtr& node) {
+    return node ? node->size : 0;
+}
+
+/**
+ * @brief Creates a node, computing its height and size from its children.
+ *
+ * @param key Packed course ID.
+ * @param course The course.
+ * @param left Left subtree.
+ * @param right Right subtree.
+ * @return The new node.
+ */
+PersistentCatalog::NodePtr PersistentCatalog::makeNode(const CourseKey& key, shared_ptr<const Course> course,
+                                                       NodePtr left, NodePtr right) {
+    int nodeHeight = max(height(left), height(right)) + 1;
+    size_t nodeSize = size(left) + size(right) + 1;
+    return make_shared<const PersistentNode>(PersistentNode{ key, move(course), move(left), move(right), nodeHeight, nodeSize });
+}
+
+/**
+ * @brief Creates a node from two subtrees, rotating if they are out of balance.
+ *
+ * Equivalent to BinarySearchTree::rebalance(), except that rotated nodes 
+ * are copied instead of relinked, since other versions may share them.
+ *
+ * @param key Packed course ID.
+ * @param course The course.
+ * @param left Left subtree.
+ * @param right Right subtree.
+ * @return Root of the balanced subtree.
+ */
+PersistentCatalog::NodePtr PersistentCatalog::balance(const CourseKey& key, shared_ptr<const Course> course,
+                                                      NodePtr left, NodePtr right) {
+    // Left Heavy
+    if (height(left) > height(right) + 1) {
+        // Left-Left
+        if (height(left->left) >= height(left->right)) {
+            return makeNode(left->key, left->course, left->left,
+                            makeNode(key, move(course), left->right, move(right)));
+        }
+        // Left-Right
+        const NodePtr& pivot = left->right;
+        return makeNode(pivot->key, pivot->course,
+                        makeNode(left->key, left->course, left->left, pivot->left),
+                        makeNode(key, move(course), pivot->right, move(right)));
+    }
+    // Right Heavy
+    if (height(right) > height(left) + 1) {
+        // Right-Right
+        if (height(right->right) >= height(right->left)) {
+            return makeNode(right->key, right->course,
+                            makeNode(key, move(course), move(left), right->left), right->right);
+        }
+        // Right-Left
+        const NodePtr& pivot = right->left;
+        return makeNode(pivot->key, pivot->course,
+                        makeNode(key, move(course), move(left), pivot->left),
+                        makeNode(right->key, right->course, pivot->right, right->right));
+    }
+    return makeNode(key, move(course), move(left), move(right));
+}
+
+/**
+ * @brief Returns a copy of a subtree with a course added.
+ *
+ * @param node Root of the subtree (recursive).
+ * @param key Packed ID of the course.
+ * @param course The course to add.
+ * @return Root of the new subtree.
+ * @throws BinarySearchTree::DuplicateCourseException if the ID already exists.
+ */
+PersistentCatalog::NodePtr PersistentCatalog::insertInto(const NodePtr& node, const CourseKey& key,
+                                                         shared_ptr<const Course> course) {
+    if (!node) {
+        return makeNode(key, move(course), nullptr, nullptr);
+    }
+
+    int order = compareCourseKeys(node->key, *node->course, key, course->courseId);
+    if (order == 0) {
+        throw BinarySearchTree::DuplicateCourseException(course->courseId);
+    }
+    if (order > 0) {
+        return balance(node->key, node->course, insertInto(node->left, key, move(course)), node->right);
+    }
+    return balance(node->key, node->course, node->left, insertInto(node->right, key, move(course)));
+}
+
+/**
+ * @brief Returns a copy of a subtree without its smallest course.
+ *
+ * @param node Root of the subtree; must not be null (recursive).
+ * @param minimum Set to the node that held the smallest course.
+ * @return Root of the new subtree.
+ */
+PersistentCatalog::NodePtr PersistentCatalog::removeMin(const NodePtr& node, NodePtr& minimum) {
+    if (!node->left) {
+        minimum = node;
+        return node->right;
+    }
+    return balance(node->key, node->course, removeMin(node->left, minimum), node->right);
+}
+
+/**
+ * @brief Returns a copy of a subtree with a course removed.
+ *
+ * If the course is not in the subtree, the subtree itself is returned and 
+ * nothing is copied.
+ *
+ * @param node Root of the subtree (recursive).
+ * @param key Packed ID of the course to remove.
+ * @param courseId The ID of the course to remove.
+ * @return Root of the new subtree.
+ */
+PersistentCatalog::NodePtr PersistentCatalog::removeFrom(const NodePtr& node, const CourseKey& key, string_view courseId) {
+    if (!node) {
+        return node;
+    }
+
+    int order = compareCourseKeys(node->key, *node->course, key, courseId);
+    if (order > 0) {
+        NodePtr left = removeFrom(node->left, key, courseId);
+        return left == node->left ? node : balance(node->key, node->course, move(left), node->right);
+    }
+    if (order < 0) {
+        NodePtr right = removeFrom(node->right, key, courseId);
+        return right == node->right ? node : balance(node->key, node->course, node->left, move(right));
+    }
+
+    // Found: splice out, or replace with the successor if there are two children
+    if (!node->left) {
+        return node->right;
+    }
+    if (!node->right) {
+        return node->left;
+    }
+    NodePtr successor;
+    NodePtr right = removeMin(node->right, successor);
+    return balance(successor->key, successor->course, node->left, move(right));
+}
+
+/**
+ * @brief Builds a perfectly balanced subtree from sorted courses.
+ *
+ * @param courses Courses in ascending ID order.
+ * @param first First position to build from.
+ * @param last One past the last position to build from.
+ * @return Root of the new subtree.
+ */
+PersistentCatalog::NodePtr PersistentCatalog::buildBalanced(const vector<shared_ptr<const Course>>& courses,
+                                                            size_t first, size_t last) {
+    if (first == last) {
+        return nullptr;
+    }
+
+    size_t middle = first + (last - first) / 2;
+    return makeNode(CourseKey::Pack(courses[middle]->courseId), courses[middle],
+                    buildBalanced(courses, first, middle), buildBalanced(courses, middle + 1, last));
+}
+
+/**
+ * @brief Returns an O(1) snapshot of the current version.
+ *
+ * Later edits to either catalog do not affect the other.
+ *
+ * @return A catalog sharing this version's nodes.
+ */
+PersistentCatalog PersistentCatalog::Snapshot() const {
+    return *this;
+}
+
+/**
+ * @brief Adds a course, leaving earlier snapshots unchanged.
+ *
+ * @param course The course to insert.
+ * @throws BinarySearchTree::DuplicateCourseException if the ID already exists.
+ */
+void PersistentCatalog::Insert(Course course) {
+    CourseKey key = CourseKey::Pack(course.courseId);
+    root = insertInto(root, key, make_shared<const Course>(move(course)));
+}
+
+/**
+ * @brief Removes a course if it exists, leaving earlier snapshots unchanged.
+ *
+ * @param courseId The ID of the course to remove.
+ */
+void PersistentCatalog::Remove(string_view courseId) {
+    root = removeFrom(root, CourseKey::Pack(courseId), courseId);
+}
+
+/**
+ * @brief Looks up a course in this version without copying it.
+ *
+ * The returned pointer stays valid while any version containing the 
+ * course is alive.
+ *
+ * @param courseId The ID of the course to look for.
+ * @return Pointer to the course, or nullptr if it is not in this version.
+ */
+const Course* PersistentCatalog::Find(string_view courseId) const {
+    CourseKey key = CourseKey::Pack(courseId);
+    const PersistentNode* node = root.get();
+
+    while (node) {
+        int order = compareCourseKeys(node->key, *node->course, key, courseId);
+        if (order == 0) {
+            return node->course.get();
+        }
+        node = order > 0 ? node->left.get() : node->right.get();
+    }
+    return nullptr;
+}
+
+/**
+ * @brief Returns the number of courses in this version.
+ */
+size_t PersistentCatalog::Size() const {
+    return size(root);
+}
+
+/**
+ * @brief Passes every course of this version to a visitor in ascending order.
+ *
+ * Uses a fixed-size stack, like BinarySearchTree::VisitInOrder().
+ *
+ * @param visit Callable taking a const Course&.
+ */
+template <typename Visitor>
+void PersistentCatalog::VisitInOrder(Visitor&& visit) const {
+    const PersistentNode* pending[BinarySearchTree::MAX_DEPTH];
+    int depth = 0;
+    const PersistentNode* node = root.get();
+
+    while (node || depth > 0) {
+        while (node) {
+            pending[depth++] = node;
+            node = node->left.get();
+        }
+        node = pending[--depth];
+        visit(*node->course);
+        node = node->right.get();
+    }
+}
+
+/**
+ * @brief Counts the nodes held by a set of versions, counting shared nodes once.
+ *
+ * A subtree already reached from an earlier version is skipped without 
+ * being walked, so this costs time proportional to the answer.
+ *
+ * @param versions The versions to account for.
+ * @return Number of distinct nodes.
+ */
+size_t PersistentCatalog::CountDistinctNodes(const vector<PersistentCatalog>& versions) {
+    unordered_set<const PersistentNode*> seen;
+    vector<const PersistentNode*> pending;
+
+    for (const PersistentCatalog& version : versions) {
+        pending.push_back(version.root.get());
+        while (!pending.empty()) {
+            const PersistentNode* node = pending.back();
+            pending.pop_back();
+            if (node && seen.insert(node).second) {
+                pending.push_back(node->left.get());
+                pending.push_back(node->right.get());
+            }
+        }
+    }
+    return seen.size();
+}
+
+//============================================================================
+// Binary Catalog
+//============================================================================
+
+/**
+ * @class MappedCatalog
+ * @brief Read-only course catalog served straight from a memory-mapped file.
+ *
+ * The file is written once from a loaded tree by Write() and then opened 
+ * with mmap (MapViewOfFile on Windows). Opening only checks the header, so 
+ * it takes the same time for any catalog size; lookups, scans and 
+ * traversals read the mapped tables in place and never build a tree.
+ *
+ * File layout (version 1, host byte order checked by the byte-order mark, 
+ * every table 8-byte aligned):
+ *   FileHeader        magic, version, byte-order mark, table offsets
+ *   CourseKey[n]      packed IDs in ascending ID order, binary searched
+ *   Record[n]         ID, name and prerequisite range of each course
+ *   StringRef[m]      prerequisite IDs, referenced by Record ranges
+ *   char[]            string heap; IDs, names and prerequisites point into it
+ *
+ * Prerequisites that name a course in the catalog share that course's ID 
+ * string in the heap.
+ */
+class MappedCatalog {
+
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+    private:
+        /// Location of a string in the heap.
+        struct StringRef {
+            uint32_t offset;
+            uint32_t length;
+        };
+
+        struct Record {
+            StringRef courseId;
+            StringRef name;
+            uint32_t firstPrerequisite;         /// Index into the prerequisite table
+            uint32_t prerequisiteCount;
+        };
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;                 /// BYTE_ORDER_MARK as written by the producer
+            uint64_t courseCount;
+            uint64_t keyTableOffset;
+            uint64_t recordTableOffset;
+            uint64_t prerequisiteTableOffset;
+            uint64_t prerequisiteCount;
+            uint64_t stringHeapOffset;
+            uint64_t stringHeapSize;
+        };
+
+        // The tables are read in place, so their layout is part of the format
+        static_assert(sizeof(StringRef) == 8 && sizeof(Record) == 24 && sizeof(FileHeader) == 72,
+                      "Binary catalog structures must not contain padding.");
+        static_assert(sizeof(CourseKey) == 16, "CourseKey must be two packed integers.");
+
+        static constexpr char MAGIC[8] = { 'A', 'B', 'C', 'U', 'C', 'A', 'T', '\0' };
+        static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+
+        const char* data;                       /// Start of the mapping
+        size_t dataSize;
+#ifdef _WIN32
+        HANDLE fileHandle;
+        HANDLE mappingHandle;
+#endif
+
+        const CourseKey* keys;
+        const Record* records;
+        const StringRef* prerequisites;
+        const char* heap;
+        size_t courseCount;
+        size_t prerequisiteTotal;               /// Entries in the prerequisite table
+        size_t heapSize;
+
+        void map(const string& filePath);
+        void unmap();
+        void validate();
+        string_view stringAt(const StringRef& ref) const;
+        size_t lowerBound(string_view courseId) const;
+
+    public:
+        /// A list of prerequisite IDs that reads from the mapping.
+        class PrerequisiteList {
+            const MappedCatalog* catalog;
+            const StringRef* refs;
+            size_t count;
+        public:
+            PrerequisiteList(const MappedCatalog* catalog, const StringRef* refs, size_t count) :
+                catalog(catalog), refs(refs), count(count) {}
+            size_t size() const { return count; }
+            bool empty() const { return count == 0; }
+            string_view at(size_t i) const;
+        };
+
+        /// One course, viewed in place. Valid while the catalog is open.
+        struct CourseView {
+            string_view courseId;
+            string_view name;
+            PrerequisiteList prerequisites;
+
+            Course ToCourse() const;
+        };
+
+        explicit MappedCatalog(const string& filePath);
+        ~MappedCatalog();
+
+        // The mapping is owned by exactly one catalog, so copying is disabled.
+        MappedCatalog(const MappedCatalog&) = delete;
+        MappedCatalog& operator=(const MappedCatalog&) = delete;
+
+        size_t Size() const;
+        CourseView At(size_t position) const;
+        optional<CourseView> Find(string_view courseId) const;
+
+        template <typename Visitor>
+        void VisitInOrder(Visitor&& visit) const;
+        template <typename Visitor>
+        size_t RangeScan(string_view first, string_view last, Visitor&& visit) const;
+        template <typename Visitor>
+        size_t PrefixScan(string_view prefix, Visitor&& visit) const;
+
+        static void Write(const string& filePath, const BinarySearchTree& tree);
+};
+
+/**
+ * @brief Maps a catalog file and checks its header.
+ *
+ * @param filePath Path to a file produced by Write().
+ * @throws runtime_error if the file cannot be mapped or is not a valid catalog.
+ */
+MappedCatalog::MappedCatalog(const string& filePath) {
+    map(filePath);
+
+    try {
+        validate();
+    }
+    catch (...) {
+        unmap();
+        throw;
+    }
+}
+
+/**
+ * @brief Unmaps the file.
+ */
+MappedCatalog::~MappedCatalog() {
+    unmap();
+}
+
+#ifdef _WIN32
+/**
+ * @brief Maps the whole file read-only (Windows).
+ *
+ * @param filePath Path to the file.
+ * @throws runtime_error if the file cannot be opened or mapped.
+ */
+void MappedCatalog::map(const string& filePath) {
+    data = nullptr;
+    dataSize = 0;
+    mappingHandle = nullptr;
+    fileHandle = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr,
+                             OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (fileHandle == INVALID_HANDLE_VALUE) {
+        throw runtime_error("Unable to open file: " + filePath);
+    }
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(fileHandle);
+        throw runtime_error("Unable to map empty or unreadable file: " + filePath);
+    }
+    dataSize = static_cast<size_t>(fileSize.QuadPart);
+
+    mappingHandle = CreateFileMappingA(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mappingHandle) {
+        data = static_cast<const char*>(MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0));
+    }
+    if (!data) {
+        if (mappingHandle) {
+            CloseHandle(mappingHandle);
+        }
+        CloseHandle(fileHandle);
+        throw runtime_error("Unable to map file: " + filePath);
+    }
+}
+
+/**
+ * @brief Releases the mapping (Windows).
+ */
+void MappedCatalog::unmap() {
+    UnmapViewOfFile(data);
+    CloseHandle(mappingHandle);
+    CloseHandle(fileHandle);
+}
+#else
+/**
+ * @brief Maps the whole file read-only (POSIX).
+ *
+ * @param filePath Path to the file.
+ * @throws runtime_error if the file cannot be opened or mapped.
+ */
+void MappedCatalog::map(const string& filePath) {
+    int fd = open(filePath.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw runtime_error("Unable to open file: " + filePath);
+    }
+
+    struct stat info;
+    if (fstat(fd, &info) != 0 || info.st_size == 0) {
+        close(fd);
+        throw runtime_error("Unable to map empty or unreadable file: " + filePath);
+    }
+    dataSize = static_cast<size_t>(info.st_size);
+
+    void* mapping = mmap(nullptr, dataSize, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);  // The mapping keeps the file alive
+    if (mapping == MAP_FAILED) {
+        throw runtime_error("Unable to map file: " + filePath);
+    }
+    data = static_cast<const char*>(mapping);
+}
+
+/**
+ * @brief Releases the mapping (POSIX).
+ */
+void MappedCatalog::unmap() {
+    munmap(const_cast<char*>(data), dataSize);
+}
+#endif
+
+/**
+ * @brief Checks the header and locates the tables.
+ *
+ * Only the header is read; string references are bounds-checked when they 
+ * are used.
+ *
+ * @throws runtime_error if the file is not a supported catalog.
+ */
+void MappedCatalog::validate() {
+    if (dataSize < sizeof(FileHeader)) {
+        throw runtime_error("Catalog file is truncated.");
+    }
+
+    FileHeader header;
+    memcpy(&header, data, sizeof(header));
+
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw runtime_error("Not a course catalog file.");
+    }
+    if (header.version != FORMAT_VERSION) {
+        throw runtime_error("Unsupported catalog version " + to_string(header.version) + ".");
+    }
+    if (header.byteOrder != BYTE_ORDER_MARK) {
+        throw runtime_error("Catalog was written on a machine with a different byte order.");
+    }
+
+    // Every table must be aligned and lie entirely inside the file
+    auto fits = [this](uint64_t offset, uint64_t count, uint64_t elementSize) {
+        return offset % 8 == 0 && offset <= dataSize && count <= (dataSize - offset) / elementSize;
+    };
+    if (!fits(header.keyTableOffset, header.courseCount, sizeof(CourseKey)) ||
+        !fits(header.recordTableOffset, header.courseCount, sizeof(Record)) ||
+        !fits(header.prerequisiteTableOffset, header.prerequisiteCount, sizeof(StringRef)) ||
+        !fits(header.stringHeapOffset, header.stringHeapSize, 1)) {
+        throw runtime_error("Catalog file is truncated or corrupt.");
+    }
+
+    courseCount = static_cast<size_t>(header.courseCount);
+    prerequisiteTotal = static_cast<size_t>(header.prerequisiteCount);
+    keys = reinterpret_cast<const CourseKey*>(data + header.keyTableOffset);
+    records = reinterpret_cast<const Record*>(data + header.recordTableOffset);
+    prerequisites = reinterpret_cast<const StringRef*>(data + header.prerequisiteTableOffset);
+    heap = data + header.stringHeapOffset;
+    heapSize = static_cast<size_t>(header.stringHeapSize);
+}
+
+/**
+ * @brief Returns the string a reference points to.
+ *
+ * @param ref Offset and length in the string heap.
+ * @return The string, viewed in place.
+ * @throws runtime_error if the reference lies outside the heap.
+ */
+string_view MappedCatalog::stringAt(const StringRef& ref) const {
+    if (ref.offset > heapSize || ref.length > heapSize - ref.offset) {
+        throw runtime_error("Catalog file is corrupt.");
+    }
+    return string_view(heap + ref.offset, ref.length);
+}
+
+/**
+ * @brief Returns the position of the first course whose ID is not less than courseId.
+ *
+ * Binary searches the packed keys, reading an ID string only to separate 
+ * IDs that share their first CourseKey::PACKED_CHARS characters.
+ *
+ * @param courseId The course ID to search for.
+ * @return Position in [0, Size()].
+ */
+size_t MappedCatalog::lowerBound(string_view courseId) const {
+    CourseKey key = CourseKey::Pack(courseId);
+    size_t first = 0;
+    size_t count = courseCount;
+
+    while (count > 0) {
+        size_t half = count / 2;
+        size_t middle = first + half;
+        const CourseKey& stored = keys[middle];
+
+        bool less;
+        if (stored.high != key.high) {
+            less = stored.high < key.high;
+        }
+        else if (stored.low != key.low) {
+            less = stored.low < key.low;
+        }
+        else {
+            less = courseId.size() >= CourseKey::PACKED_CHARS && stringAt(records[middle].courseId) < courseId;
+        }
+
+        if (less) {
+            first = middle + 1;
+            count -= half + 1;
+        }
+        else {
+            count = half;
+        }
+    }
+    return first;
+}
+
+/**
+ * @brief Returns one prerequisite ID.
+ *
+ * @param i Index of the prerequisite.
+ * @throws out_of_range if i >= size().
+ */
+string_view MappedCatalog::PrerequisiteList::at(size_t i) const {
+    if (i >= count) {
+        throw out_of_range("Prerequisite index out of range.");
+    }
+    return catalog->stringAt(refs[i]);
+}
+
+/**
+ * @brief Copies the viewed course into a standalone Course.
+ */
+Course MappedCatalog::CourseView::ToCourse() const {
+    Course course;
+    course.courseId = courseId;
+    course.name = name;
+    for (size_t i = 0; i < prerequisites.size(); ++i) {
+        course.prerequisites.emplace_back(prerequisites.at(i));
+    }
+    return course;
+}
+
+/**
+ * @brief Returns the number of courses in the catalog.
+ */
+size_t MappedCatalog::Size() const {
+    return courseCount;
+}
+
+/**
+ * @brief Returns the course at a position in ID order.
+ *
+ * @param position Zero-based position; must be less than Size().
+ * @return A view of the course.
+ */
+MappedCatalog::CourseView MappedCatalog::At(size_t position) const {
+    const Record& record = records[position];
+
+    if (record.firstPrerequisite > prerequisiteTotal ||
+        record.prerequisiteCount > prerequisiteTotal - record.firstPrerequisite) {
+        throw runtime_error("Catalog file is corrupt.");
+    }
+    return CourseView{ stringAt(record.courseId), stringAt(record.name),
+                       PrerequisiteList(this, prerequisites + record.firstPrerequisite, record.prerequisiteCount) };
+}
+
+/**
+ * @brief Looks up a course by ID.
+ *
+ * @param courseId The course ID to find.
+ * @return A view of the course, or nullopt if it is not in the catalog.
+ */
+optional<MappedCatalog::CourseView> MappedCatalog::Find(string_view courseId) const {
+    size_t position = lowerBound(courseId);
+
+    if (position == courseCount || stringAt(records[position].courseId) != courseId) {
+        return nullopt;
+    }
+    return At(position);
+}
+
+/**
+ * @brief Passes every course to a visitor in ID order.
+ *
+ * The record table is already in ID order, so this is a linear walk of 
+ * the mapping.
+ *
+ * @param visit Callable taking a const CourseView&.
+ */
+template <typename Visitor>
+void MappedCatalog::VisitInOrder(Visitor&& visit) const {
+    for (size_t position = 0; position < courseCount; ++position) {
+        visit(At(position));
+    }
+}
+
+/**
+ * @brief Passes every course with an ID in [first, last] to a visitor.
+ *
+ * @param first Smallest course ID to include.
+ * @param last Largest course ID to include.
+ * @param visit Callable taking a const CourseView&.
+ * @return Number of courses visited.
+ */
+template <typename Visitor>
+size_t MappedCatalog::RangeScan(string_view first, string_view last, Visitor&& visit) const {
+    size_t count = 0;
+
+    for (size_t position = lowerBound(first); position < courseCount; ++position) {
+        CourseView course = At(position);
+        if (course.courseId > last) {
+            break;
+        }
+        visit(course);
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Passes every course whose ID starts with a prefix to a visitor.
+ *
+ * @param prefix The leading characters to match (e.g. "CSCI3").
+ * @param visit Callable taking a const CourseView&.
+ * @return Number of courses visited.
+ */
+template <typename Visitor>
+size_t MappedCatalog::PrefixScan(string_view prefix, Visitor&& visit) const {
+    size_t count = 0;
+
+    for (size_t position = lowerBound(prefix); position < courseCount; ++position) {
+        CourseView course = At(position);
+        if (course.courseId.substr(0, prefix.size()) != prefix) {
+            break;
+        }
+        visit(course);
+        ++count;
+    }
+    return count;
+}
+
+/**
+ * @brief Writes a tree's courses to a binary catalog file.
+ *
+ * Strings are interned, so a prerequisite that appears many times is 
+ * stored once.
+ *
+ * @param filePath Path of the file to create or replace.
+ * @param tree The courses to write.
+ * @throws runtime_error if the file cannot be written or the strings 
+ *         exceed the 4 GiB heap limit.
+ */
+void MappedCatalog::Write(const string& filePath, const BinarySearchTree& tree) {
+    vector<CourseKey> keyTable;
+    vector<Record> recordTable;
+    vector<StringRef> prerequisiteTable;
+    string stringHeap;
+    unordered_map<string, StringRef> interned;
+
+    auto intern = [&](string_view text) {
+        auto found = interned.find(string(text));
+        if (found != interned.end()) {
+            return found->second;
+        }
+        if (stringHeap.size() + text.size() > numeric_limits<uint32_t>::max()) {
+            throw runtime_error("Catalog strings exceed the binary format's 4 GiB limit.");
+        }
+        StringRef ref = { static_cast<uint32_t>(stringHeap.size()), static_cast<uint32_t>(text.size()) };
+        stringHeap.append(text);
+        interned.emplace(string(text), ref);
+        return ref;
+    };
+
+    keyTable.reserve(tree.Size());
+    recordTable.reserve(tree.Size());
+
+    // Intern every ID first so prerequisites that name a course reuse its string
+    tree.VisitInOrder([&](const Course& course) {
+        keyTable.push_back(CourseKey::Pack(course.courseId));
+        recordTable.push_back(Record{ intern(course.courseId), StringRef{ 0, 0 }, 0, 0 });
+    });
+
+    size_t position = 0;
+    tree.VisitInOrder([&](const Course& course) {
+        Record& record = recordTable[position++];
+        record.name = intern(course.name);
+        record.firstPrerequisite = static_cast<uint32_t>(prerequisiteTable.size());
+        record.prerequisiteCount = static_cast<uint32_t>(course.prerequisites.size());
+
+        for (const pmr::string& prerequisite : course.prerequisites) {
+            prerequisiteTable.push_back(intern(prerequisite));
+        }
+    });
+
+    if (prerequisiteTable.size() > numeric_limits<uint32_t>::max()) {
+        throw runtime_error("Catalog has too many prerequisites for the binary format.");
+    }
+
+    auto align = [](uint64_t offset) { return (offset + 7) & ~uint64_t(7); };
+
+    FileHeader header = {};
+    memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = FORMAT_VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.courseCount = keyTable.size();
+    header.keyTableOffset = align(sizeof(FileHeader));
+    header.recordTableOffset = align(header.keyTableOffset + keyTable.size() * sizeof(CourseKey));
+    header.prerequisiteTableOffset = align(header.recordTableOffset + recordTable.size() * sizeof(Record));
+    header.prerequisiteCount = prerequisiteTable.size();
+    header.stringHeapOffset = align(header.prerequisiteTableOffset + prerequisiteTable.size() * sizeof(StringRef));
+    header.stringHeapSize = stringHeap.size();
+
+    ofstream out(filePath, ios::binary | ios::trunc);
+    if (!out.is_open()) {
+        throw runtime_error("Unable to create file: " + filePath);
+    }
+
+    // Pads the file with zeros up to the next table
+    auto writeAt = [&out](uint64_t offset, const void* bytes, size_t length) {
+        static const char zeros[8] = {};
+        out.write(zeros, static_cast<streamsize>(offset - static_cast<uint64_t>(out.tellp())));
+        out.write(static_cast<const char*>(bytes), static_cast<streamsize>(length));
+    };
+
+    writeAt(0, &header, sizeof(header));
+    writeAt(header.keyTableOffset, keyTable.data(), keyTable.size() * sizeof(CourseKey));
+    writeAt(header.recordTableOffset, recordTable.data(), recordTable.size() * sizeof(Record));
+    writeAt(header.prerequisiteTableOffset, prerequisiteTable.data(), prerequisiteTable.size() * sizeof(StringRef));
+    writeAt(header.stringHeapOffset, stringHeap.data(), stringHeap.size());
+
+    if (!out.flush()) {
+        throw runtime_error("Unable to write file: " + filePath);
+    }
+}
+
+//============================================================================
+// Write-Ahead Log
+//============================================================================
+
+/**
+ * @brief Computes the CRC-32 (IEEE) of a byte range.
+ *
+ * @param bytes The bytes to checksum.
+ * @param length Number of bytes.
+ * @return The checksum.
+ */
+uint32_t crc32(const char* bytes, size_t length) {
+    static const auto table = [] {
+        array<uint32_t, 256> entries{};
+        for (uint32_t i = 0; i < 256; ++i) {
+            uint32_t value = i;
+            for (int bit = 0; bit < 8; ++bit) {
+                value = (value & 1) ? 0xEDB88320u ^ (value >> 1) : value >> 1;
+            }
+            entries[i] = value;
+        }
+        return entries;
+    }();
+
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < length; ++i) {
+        crc = table[(crc ^ static_cast<unsigned char>(bytes[i])) & 0xFF] ^ (crc >> 8);
+    }
+    return crc ^ 0xFFFFFFFFu;
+}
+
+/**
+ * @class CatalogLog
+ * @brief Append-only log that makes individual catalog edits durable.
+ *
+ * Each Insert or Remove applied to a tree is appended as one checksummed 
+ * record, so an edit costs one small write instead of rewriting the CSV. 
+ * Commit() uses group commit: the first thread to commit becomes the 
+ * leader and writes and syncs every record appended so far in one batch, 
+ * while threads that commit in the meantime wait for that batch (or the 
+ * next) instead of issuing their own fsync.
+ *
+ * At startup Replay() applies the log on top of the CSV catalog. A record 
+ * torn by a crash fails its checksum; it and everything after it are 
+ * dropped. Compact() writes the current tree as a new CSV snapshot and 
+ * empties the log.
+ *
+ * Replaying a log on top of a snapshot that already contains its edits 
+ * leaves the catalog unchanged (inserts of existing courses are skipped), 
+ * so a crash between the two steps of Compact() loses nothing.
+ *
+ * File layout: FileHeader, then records of
+ *   uint32_t length   bytes after the checksum
+ *   uint32_t crc      CRC-32 of those bytes
+ *   uint8_t  type     Operation
+ *   strings           each a uint32_t length and its characters; 
+ *                     Insert: ID, name, prerequisite count, prerequisites
+ *                     Remove: ID
+ */
+class CatalogLog {
+
+    public:
+        static constexpr uint32_t FORMAT_VERSION = 1;
+
+    private:
+        enum class Operation : uint8_t { Insert = 1, Remove = 2 };
+
+        struct FileHeader {
+            char magic[8];
+            uint32_t version;
+            uint32_t byteOrder;                 /// BYTE_ORDER_MARK as written by the producer
+        };
+
+        static constexpr char MAGIC[8] = { 'A', 'B', 'C', 'U', 'L', 'O', 'G', '\0' };
+        static constexpr uint32_t BYTE_ORDER_MARK = 0x01020304;
+        static constexpr size_t RECORD_HEADER_BYTES = 2 * sizeof(uint32_t);
+
+        string filePath;
+#ifdef _WIN32
+        HANDLE file;
+#else
+        int file;
+#endif
+
+        mutex logMutex;
+        condition_variable flushed;
+        string pending;                         /// Encoded records not yet written
+        uint64_t appended;                      /// Sequence number of the last appended record
+        uint64_t durable;                       /// Sequence number of the last synced record
+        bool flushing;                          /// A leader is writing a batch
+        bool failed;                            /// A write failed; the log is unusable
+
+        void writeAll(const string& bytes);
+        void sync();
+        void truncate(uint64_t length);
+        uint64_t append(Operation operation, const string& payload);
+
+        static void appendString(string& out, string_view text);
+        static bool readString(const char*& cursor, const char* end, string& text);
+        static size_t applyRecords(const string& contents, BinarySearchTree& tree, size_t& intactLength);
+
+    public:
+        explicit CatalogLog(const string& filePath);
+        ~CatalogLog();
+
+        // The log owns its file handle, so copying is disabled.
+        CatalogLog(const CatalogLog&) = delete;
+        CatalogLog& operator=(const CatalogLog&) = delete;
+
+        size_t Replay(BinarySearchTree& tree);
+        uint64_t AppendInsert(const Course& course);
+        uint64_t AppendRemove(string_view courseId);
+        void Commit(uint64_t sequence);
+        void Compact(const BinarySearchTree& tree, const string& csvPath);
+
+        static size_t ReplayReadOnly(const string& filePath, BinarySearchTree& tree);
+        static void SyncFile(const string& path);
+};
+
+/**
+ * @brief Opens a log, creating it if it does not exist.
+ *
+ * @param filePath Path to the log file.
+ * @throws runtime_error if the file cannot be opened or is not a catalog log.
+ */
+CatalogLog::CatalogLog(const string& filePath) : filePath(filePath) {
+    appended = 0;
+    durable = 0;
+    flushing = false;
+    failed = false;
+
+#ifdef _WIN32
+    file = CreateFileA(filePath.c_str(), GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ, nullptr,
+                       OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) {
+        throw runtime_error("Unable to open log: " + filePath);
+    }
+    LARGE_INTEGER fileSize;
+    uint64_t length = GetFileSizeEx(file, &fileSize) ? static_cast<uint64_t>(fileSize.QuadPart) : 0;
+#else
+    file = open(filePath.c_str(), O_RDWR | O_CREAT | O_APPEND, 0644);
+    if (file < 0) {
+        throw runtime_error("Unable to open log: " + filePath);
+    }
+    struct stat info;
+    uint64_t length = fstat(file, &info) == 0 ? static_cast<uint64_t>(info.st_size) : 0;
+#endif
+
+    try {
+        // A new (or empty) log gets a header; an existing one must match
+        if (length < sizeof(FileHeader)) {
+            FileHeader header = {};
+            memcpy(header.magic, MAGIC, sizeof(MAGIC));
+            header.version = FORMAT_VERSION;
+            header.byteOrder = BYTE_ORDER_MARK;
+
+            truncate(0);
+            writeAll(string(reinterpret_cast<const char*>(&header), sizeof(header)));
+            sync();
+        }
+        else {
+            FileHeader header;
+            ifstream in(filePath, ios::binary);
+            in.read(reinterpret_cast<char*>(&header), sizeof(header));
+
+            if (!in || memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+                throw runtime_error("Not a catalog log: " + filePath);
+            }
+            if (header.version != FORMAT_VERSION || header.byteOrder != BYTE_ORDER_MARK) {
+                throw runtime_error("Unsupported catalog log version or byte order: " + filePath);
+            }
+        }
+    }
+    catch (...) {
+#ifdef _WIN32
+        CloseHandle(file);
+#else
+        close(file);
+#endif
+        throw;
+    }
+}
+
+/**
+ * @brief Commits anything still pending and closes the log.
+ */
+CatalogLog::~CatalogLog() {
+    try {
+        Commit(appended);
+    }
+    catch (const exception& ex) {
+        cerr << "Warning: unable to flush log " << filePath << ": " << ex.what() << endl;
+    }
+#ifdef _WIN32
+    CloseHandle(file);
+#else
+    close(file);
+#endif
+}
+
+#ifdef _WIN32
+/**
+ * @brief Appends bytes to the end of the file (Windows).
+ *
+ * @throws runtime_error if the write fails.
+ */
+void CatalogLog::writeAll(const string& bytes) {
+    LARGE_INTEGER end = {};
+    SetFilePointerEx(file, end, nullptr, FILE_END);
+
+    size_t written = 0;
+    while (written < bytes.size()) {
+        DWORD chunk = static_cast<DWORD>(min<size_t>(bytes.size() - written, 1 << 30));
+        DWORD count = 0;
+        if (!WriteFile(file, bytes.data() + written, chunk, &count, nullptr)) {
+            throw runtime_error("Unable to write log: " + filePath);
+        }
+        written += count;
+    }
+}
+
+/**
+ * @brief Forces written records to disk (Windows).
+ *
+ * @throws runtime_error if the flush fails.
+ */
+void CatalogLog::sync() {
+    if (!FlushFileBuffers(file)) {
+        throw runtime_error("Unable to sync log: " + filePath);
+    }
+}
+
+/**
+ * @brief Cuts the file to a length (Windows).
+ *
+ * @throws runtime_error if the file cannot be resized.
+ */
+void CatalogLog::truncate(uint64_t length) {
+    LARGE_INTEGER position;
+    position.QuadPart = static_cast<LONGLONG>(length);
+    if (!SetFilePointerEx(file, position, nullptr, FILE_BEGIN) || !SetEndOfFile(file)) {
+        throw runtime_error("Unable to truncate log: " + filePath);
+    }
+}
+
+/**
+ * @brief Forces a file's contents to disk (Windows).
+ *
+ * @param path Path to the file.
+ * @throws runtime_error if the file cannot be opened or flushed.
+ */
+void CatalogLog::SyncFile(const string& path) {
+    HANDLE handle = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, nullptr,
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    bool synced = handle != INVALID_HANDLE_VALUE && FlushFileBuffers(handle);
+    if (handle != INVALID_HANDLE_VALUE) {
+        CloseHandle(handle);
+    }
+    if (!synced) {
+        throw runtime_error("Unable to sync file: " + path);
+    }
+}
+#else
+/**
+ * @brief Appends bytes to the end of the file (POSIX).
+ *
+ * @throws runtime_error if the write fails.
+ */
+void CatalogLog::writeAll(const string& bytes) {
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t count = write(file, bytes.data() + written, bytes.size() - written);
+        if (count < 0 && errno == EINTR) {
+            continue;
+        }
+        if (count < 0) {
+            throw runtime_error("Unable to write log: " + filePath);
+        }
+        written += static_cast<size_t>(count);
+    }
+}
+
+/**
+ * @brief Forces written records to disk (POSIX).
+ *
+ * @throws runtime_error if the sync fails.
+ */
+void CatalogLog::sync() {
+    if (fsync(file) != 0) {
+        throw runtime_error("Unable to sync log: " + filePath);
+    }
+}
+
+/**
+ * @brief Cuts the file to a length (POSIX).
+ *
+ * @throws runtime_error if the file cannot be resized.
+ */
+void CatalogLog::truncate(uint64_t length) {
+    if (ftruncate(file, static_cast<off_t>(length)) != 0) {
+        throw runtime_error("Unable to truncate log: " + filePath);
+    }
+}
+
+/**
+ * @brief Forces a file's contents to disk (POSIX).
+ *
+ * @param path Path to the file, or a directory to sync its entries.
+ * @throws runtime_error if the file cannot be opened or synced.
+ */
+void CatalogLog::SyncFile(const string& path) {
+    int fd = open(path.c_str(), O_RDONLY);
+    bool synced = fd >= 0 && fsync(fd) == 0;
+    if (fd >= 0) {
+        close(fd);
+    }
+    if (!synced) {
+        throw runtime_error("Unable to sync file: " + path);
+    }
+}
+#endif
+
+/**
+ * @brief Appends a length-prefixed string to an encoded record.
+ */
+void CatalogLog::appendString(string& out, string_view text) {
+    uint32_t length = static_cast<uint32_t>(text.size());
+    out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    out.append(text);
+}
+
+/**
+ * @brief Reads a length-prefixed string from an encoded record.
+ *
+ * @param cursor Read position; advanced past the string.
+ * @param end End of the record.
+ * @param text Receives the string.
+ * @return False if the record ends before the string does.
+ */
+bool CatalogLog::readString(const char*& cursor, const char* end, string& text) {
+    uint32_t length;
+    if (static_cast<size_t>(end - cursor) < sizeof(length)) {
+        return false;
+    }
+    memcpy(&length, cursor, sizeof(length));
+    cursor += sizeof(length);
+
+    if (static_cast<size_t>(end - cursor) < length) {
+        return false;
+    }
+    text.assign(cursor, length);
+    cursor += length;
+    return true;
+}
+
+/**
+ * @brief Frames a record and queues it for the next commit.
+ *
+ * @param operation The kind of edit.
+ * @param payload The encoded strings of the edit.
+ * @return The record's sequence number.
+ */
+uint64_t CatalogLog::append(Operation operation, const string& payload) {
+    string body;
+    body.reserve(1 + payload.size());
+    body.push_back(static_cast<char>(operation));
+    body.append(payload);
+
+    if (body.size() > numeric_limits<uint32_t>::max()) {
+        throw runtime_error("Log record is too large.");
+    }
+    uint32_t length = static_cast<uint32_t>(body.size());
+    uint32_t crc = crc32(body.data(), body.size());
+
+    lock_guard<mutex> lock(logMutex);
+    pending.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    pending.append(reinterpret_cast<const char*>(&crc), sizeof(crc));
+    pending.append(body);
+    return ++appended;
+}
+
+/**
+ * @brief Applies the intact records of a log file's contents to a tree.
+ *
+ * @param contents The whole log file, header included.
+ * @param tree The tree to apply the edits to.
+ * @param intactLength Receives the length of the header and the records 
+ *                     applied; anything after it is damaged.
+ * @return Number of records applied.
+ */
+size_t CatalogLog::applyRecords(const string& contents, BinarySearchTree& tree, size_t& intactLength) {
+    const char* cursor = contents.data() + sizeof(FileHeader);
+    const char* end = contents.data() + contents.size();
+    size_t applied = 0;
+
+    while (static_cast<size_t>(end - cursor) >= RECORD_HEADER_BYTES) {
+        uint32_t length;
+        uint32_t crc;
+        memcpy(&length, cursor, sizeof(length));
+        memcpy(&crc, cursor + sizeof(length), sizeof(crc));
+
+        const char* body = cursor + RECORD_HEADER_BYTES;
+        if (length == 0 || static_cast<size_t>(end - body) < length || crc32(body, length) != crc) {
+            break;
+        }
+
+        const char* field = body + 1;
+        const char* bodyEnd = body + length;
+        Operation operation = static_cast<Operation>(body[0]);
+        Course course;
+        string text;
+
+        if (operation == Operation::Insert) {
+            uint32_t prerequisiteCount = 0;
+            bool intact = readString(field, bodyEnd, text);
+            course.courseId = text;
+            intact = intact && readString(field, bodyEnd, text);
+            course.name = text;
+
+            if (intact && static_cast<size_t>(bodyEnd - field) >= sizeof(prerequisiteCount)) {
+                memcpy(&prerequisiteCount, field, sizeof(prerequisiteCount));
+                field += sizeof(prerequisiteCount);
+            }
+            else {
+                intact = false;
+            }
+            for (uint32_t i = 0; intact && i < prerequisiteCount; ++i) {
+                intact = readString(field, bodyEnd, text);
+                course.prerequisites.emplace_back(text);
+            }
+            if (!intact) {
+                break;
+            }
+
+            // Already present when the snapshot includes this edit
+            if (!tree.Contains(course.courseId)) {
+                tree.Insert(move(course));
+            }
+        }
+        else if (operation == Operation::Remove) {
+            if (!readString(field, bodyEnd, text)) {
+                break;
+            }
+            tree.Remove(text);
+        }
+        else {
+            break;
+        }
+
+        cursor = bodyEnd;
+        ++applied;
+    }
+
+    intactLength = static_cast<size_t>(cursor - contents.data());
+    return applied;
+}
+
+/**
+ * @brief Applies every intact record in the log to a tree.
+ *
+ * Call once, before appending. Reading stops at the first record that is 
+ * truncated or fails its checksum, and the file is cut back to the last 
+ * intact record so later appends follow it.
+ *
+ * @param tree The tree to apply the edits to, normally freshly loaded 
+ *             from the CSV snapshot.
+ * @return Number of records applied.
+ * @throws runtime_error if the file cannot be read or truncated.
+ */
+size_t CatalogLog::Replay(BinarySearchTree& tree) {
+    ifstream in(filePath, ios::binary);
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (in.bad()) {
+        throw runtime_error("Unable to read log: " + filePath);
+    }
+
+    if (contents.size() < sizeof(FileHeader)) {
+        return 0;
+    }
+
+    size_t intactLength;
+    size_t applied = applyRecords(contents, tree, intactLength);
+
+    // Drop a torn tail so the next record starts on a clean boundary
+    if (intactLength != contents.size()) {
+        cerr << "Warning: discarding " << (contents.size() - intactLength) << " damaged byte(s) at the end of " << filePath << endl;
+        truncate(intactLength);
+        sync();
+    }
+    return applied;
+}
+
+/**
+ * @brief Applies a log's intact records to a tree without opening it for writing.
+ *
+ * For runs that only read the catalog. A missing log means there are no 
+ * edits, and a damaged tail is reported and skipped but left in place for 
+ * the next Replay() to repair.
+ *
+ * @param filePath Path to the log file.
+ * @param tree The tree to apply the edits to.
+ * @return Number of records applied.
+ * @throws runtime_error if the file exists but cannot be read or is not a 
+ *         catalog log of this version.
+ */
+size_t CatalogLog::ReplayReadOnly(const string& filePath, BinarySearchTree& tree) {
+    ifstream in(filePath, ios::binary);
+    if (!in) {
+        return 0;
+    }
+    string contents((istreambuf_iterator<char>(in)), istreambuf_iterator<char>());
+    if (in.bad()) {
+        throw runtime_error("Unable to read log: " + filePath);
+    }
+
+    if (contents.size() < sizeof(FileHeader)) {
+        return 0;
+    }
+
+    FileHeader header;
+    memcpy(&header, contents.data(), sizeof(header));
+    if (memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0) {
+        throw runtime_error("Not a catalog log: " + filePath);
+    }
+    if (header.version != FORMAT_VERSION || header.byteOrder != BYTE_ORDER_MARK) {
+        throw runtime_error("Unsupported catalog log version or byte order: " + filePath);
+    }
+
+    size_t intactLength;
+    size_t applied = applyRecords(contents, tree, intactLength);
+
+    if (intactLength != contents.size()) {
+        cerr << "Warning: discarding " << (contents.size() - intactLength) << " damaged byte(s) at the end of " << filePath << endl;
+    }
+    return applied;
+}
+
+/**
+ * @brief Queues an insert for the next commit.
+ *
+ * Apply the insert to the tree first, so only edits that succeeded are 
+ * logged, and append edits in the order they were applied.
+ *
+ * @param course The inserted course.
+ * @return Sequence number to pass to Commit().
+ */
+uint64_t CatalogLog::AppendInsert(const Course& course) {
+    string payload;
+    appendString(payload, course.courseId);
+    appendString(payload, course.name);
+
+    uint32_t prerequisiteCount = static_cast<uint32_t>(course.prerequisites.size());
+    payload.append(reinterpret_cast<const char*>(&prerequisiteCount), sizeof(prerequisiteCount));
+    for (const pmr::string& prerequisite : course.prerequisites) {
+        appendString(payload, prerequisite);
+    }
+    return append(Operation::Insert, payload);
+}
+
+/**
+ * @brief Queues a removal for the next commit.
+ *
+ * @param courseId ID of the removed course.
+ * @return Sequence number to pass to Commit().
+ */
+uint64_t CatalogLog::AppendRemove(string_view courseId) {
+    string payload;
+    appendString(payload, courseId);
+    return append(Operation::Remove, payload);
+}
+
+/**
+ * @brief Waits until a record and everything appended before it is on disk.
+ *
+ * If no other thread is flushing, this thread writes all pending records 
+ * with a single write and a single sync; otherwise it waits for the batch 
+ * in progress and, if that did not cover its record, leads the next one.
+ *
+ * @param sequence Sequence number returned by AppendInsert() or AppendRemove().
+ * @throws runtime_error if the log could not be written.
+ */
+void CatalogLog::Commit(uint64_t sequence) {
+    unique_lock<mutex> lock(logMutex);
+
+    while (durable < sequence) {
+        if (failed) {
+            throw runtime_error("Log " + filePath + " is unusable after a failed write.");
+        }
+        if (flushing) {
+            flushed.wait(lock);
+            continue;
+        }
+
+        // Become the leader for everything appended so far
+        flushing = true;
+        string batch;
+        batch.swap(pending);
+        uint64_t batchEnd = appended;
+        lock.unlock();
+
+        bool written = true;
+        try {
+            writeAll(batch);
+            sync();
+        }
+        catch (const exception&) {
+            written = false;
+        }
+
+        lock.lock();
+        flushing = false;
+        if (written) {
+            durable = batchEnd;
+        }
+        else {
+            failed = true;
+        }
+        flushed.notify_all();
+    }
+}
+
+/**
+ * @brief Writes a tree as the new CSV snapshot and empties the log.
+ *
+ * The snapshot is written to a temporary file, synced, and renamed over 
+ * the old one, so a crash leaves either the old snapshot with the full log 
+ * or the new snapshot. No edits may be applied while compacting.
+ *
+ * @param tree The catalog, including every logged edit.
+ * @param csvPath Path of the CSV snapshot to replace.
+ * @throws runtime_error if the snapshot cannot be written or the log reset.
+ */
+void CatalogLog::Compact(const BinarySearchTree& tree, const string& csvPath) {
+    uint64_t last;
+    {
+        lock_guard<mutex> lock(logMutex);
+        last = appended;
+    }
+    Commit(last);
+
+    string tempPath = csvPath + ".tmp";
+    {
+        ofstream out(tempPath, ios::trunc);
+        tree.VisitInOrder([&out](const Course& course) {
+            out << course.courseId << ',' << course.name;
+            for (const pmr::string& prerequisite : course.prerequisites) {
+                out << ',' << prerequisite;
+            }
+            out << '\n';
+        });
+        if (!out.flush()) {
+            throw runtime_error("Unable to write snapshot: " + tempPath);
+        }
+    }
+    SyncFile(tempPath);
+
+#ifdef _WIN32
+    if (!MoveFileExA(tempPath.c_str(), csvPath.c_str(), MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH)) {
+        throw runtime_error("Unable to replace snapshot: " + csvPath);
+    }
+#else
+    if (rename(tempPath.c_str(), csvPath.c_str()) != 0) {
+        throw runtime_error("Unable to replace snapshot: " + csvPath);
+    }
+    size_t slash = csvPath.find_last_of('/');
+    SyncFile(slash == string::npos ? "." : csvPath.substr(0, slash + 1));
+#endif
+
+    lock_guard<mutex> lock(logMutex);
+    truncate(sizeof(FileHeader));
+    sync();
+}
+
+//============================================================================
+// CSV Tokenizer
+//============================================================================
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero mask.
+ */
+inline unsigned countTrailingZeros(uint32_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctz(mask));
+#endif
+}
+
+/**
+ * @brief Returns the index of the lowest set bit of a non-zero 64-bit mask.
+ */
+inline unsigned countTrailingZeros(uint64_t mask) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, mask);
+    return static_cast<unsigned>(index);
+#else
+    return static_cast<unsigned>(__builtin_ctzll(mask));
+#endif
+}
+
+/**
+ * @brief Finds the next delimiter or newline.
+ *
+ * Compares 32 bytes at a time with AVX2 or 16 with SSE2 when the compiler 
+ * targets them, and finishes the tail (or the whole range on other 
+ * targets) one byte at a time.
+ *
+ * @param cursor Start of the range to search.
+ * @param end End of the range.
+ * @param delimiter Field separator (e.g. ',').
+ * @return Pointer to the first delimiter or '\n', or end if there is none.
+ */
+inline const char* findFieldEnd(const char* cursor, const char* end, char delimiter) {
+#if defined(ABCU_USE_AVX2)
+    const __m256i wideDelimiters = _mm256_set1_epi8(delimiter);
+    const __m256i wideNewlines = _mm256_set1_epi8('\n');
+    while (end - cursor >= 32) {
+        __m256i block = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(cursor));
+        uint32_t mask = static_cast<uint32_t>(_mm256_movemask_epi8(
+            _mm256_or_si256(_mm256_cmpeq_epi8(block, wideDelimiters), _mm256_cmpeq_epi8(block, wideNewlines))));
+        if (mask != 0) {
+            return cursor + countTrailingZeros(mask);
+        }
+        cursor += 32;
+    }
+#endif
+#if defined(ABCU_USE_SSE2)
+    const __m128i delimiters = _mm_set1_epi8(delimiter);
+    const __m128i newlines = _mm_set1_epi8('\n');
+    while (end - cursor >= 16) {
+        __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(cursor));
+        uint32_t mask = static_cast<uint32_t>(_mm_movemask_epi8(
+            _mm_or_si128(_mm_cmpeq_epi8(block, delimiters), _mm_cmpeq_epi8(block, newlines))));
+        if (mask != 0) {
+            return cursor + countTrailingZeros(mask);
+        }
+        cursor += 16;
+    }
+#endif
+    while (cursor != end && *cursor != delimiter && *cursor != '\n') {
+        ++cursor;
+    }
+    return cursor;
+}
+
+/**
+ * @class CsvTokenizer
+ * @brief Splits CSV text into rows of string_view fields without copying.
+ *
+ * The fields point into the text, which must outlive them; the caller's 
+ * field vector is cleared and refilled for each row, so after the first 
+ * few rows no allocation takes place. Fields are split the same way 
+ * getline() with a delimiter splits them: empty fields are kept except a 
+ * trailing one, and an empty line has no fields. A '\r' before the newline 
+ * is dropped.
+ */
+class CsvTokenizer {
+
+    private:
+        const char* cursor;
+        const char* end;
+        char delimiter;
+
+    public:
+        explicit CsvTokenizer(string_view text, char delimiter = ',');
+
+        bool NextRow(vector<string_view>& fields);
+};
+
+/**
+ * @brief Constructs a tokenizer over a block of text.
+ *
+ * @param text The CSV text; not copied.
+ * @param delimiter Field separator.
+ */
+CsvTokenizer::CsvTokenizer(string_view text, char delimiter) {
+    cursor = text.data();
+    end = text.data() + text.size();
+    this->delimiter = delimiter;
+}
+
+/**
+ * @brief Reads the next row.
+ *
+ * @param fields Cleared, then filled with the row's fields.
+ * @return False once the text is exhausted.
+ */
+bool CsvTokenizer::NextRow(vector<string_view>& fields) {
+    fields.clear();
+    if (cursor == end) {
+        return false;
+    }
+
+    while (true) {
+        const char* stop = findFieldEnd(cursor, end, delimiter);
+        string_view field(cursor, static_cast<size_t>(stop - cursor));
+        bool lineEnd = stop == end || *stop == '\n';
+
+        if (lineEnd && !field.empty() && field.back() == '\r') {
+            field.remove_suffix(1);
+        }
+        if (!lineEnd || !field.empty()) {
+            fields.push_back(field);
+        }
+
+        cursor = stop == end ? end : stop + 1;
+        if (lineEnd) {
+            return true;
+        }
+    }
+}
+
+//============================================================================
+// Streaming Ingestion
+//============================================================================
+
+/**
+ * @class BoundedQueue
+ * @brief Fixed-capacity lock-free queue for any number of producers and consumers.
+ *
+ * Each cell carries a sequence number that tells producers and consumers 
+ * whose turn it is, so Push and Pop claim a cell with a single 
+ * compare-and-swap and never take a lock. A full queue makes Push() wait, 
+ * which slows the producing stage down to the pace of the consumer 
+ * (backpressure), and an empty queue makes Pop() wait until something 
+ * arrives or the queue is closed.
+ *
+ * A waiting thread yields for QUEUE_SPIN_LIMIT attempts and then sleeps on 
+ * a condition variable, so a stage stalled on a slow pipe does not burn a 
+ * core. The lock is only taken to sleep, and by the other side to wake a 
+ * thread that is known to be sleeping.
+ */
+template <typename T>
+class BoundedQueue {
+
+    private:
+        struct Cell {
+            atomic<size_t> sequence;
+            T value;
+        };
+
+        unique_ptr<Cell[]> cells;
+        size_t mask;
+        alignas(64) atomic<size_t> head;    /// Next cell to pop
+        alignas(64) atomic<size_t> tail;    /// Next cell to push
+        atomic<bool> closed;
+        atomic<unsigned> sleepers;          /// Threads waiting on changed
+        mutex sleepMutex;
+        condition_variable changed;
+
+        bool tryPush(T& value);
+        bool tryPop(T& value);
+        bool mayPush() const;
+        bool mayPop() const;
+        template <typename Ready>
+        void sleepUntil(Ready ready);
+        void wakeSleepers();
+
+    public:
+        static constexpr unsigned QUEUE_SPIN_LIMIT = 64;
+
+        explicit BoundedQueue(size_t capacity);
+
+        bool Push(T value);
+        bool Pop(T& value);
+        void Close();
+};
+
+/**
+ * @brief Constructs an empty queue.
+ *
+ * @param capacity Minimum number of elements; rounded up to a power of two.
+ */
+template <typename T>
+BoundedQueue<T>::BoundedQueue(size_t capacity) {
+    size_t size = 2;
+    while (size < capacity) {
+        size *= 2;
+    }
+
+    cells = make_unique<Cell[]>(size);
+    for (size_t i = 0; i < size; ++i) {
+        cells[i].sequence.store(i, memory_order_relaxed);
+    }
+    mask = size - 1;
+    head.store(0, memory_order_relaxed);
+    tail.store(0, memory_order_relaxed);
+    closed.store(false, memory_order_relaxed);
+    sleepers.store(0, memory_order_relaxed);
+}
+
+/**
+ * @brief Pushes a value if there is room.
+ *
+ * @param value Moved from on success.
+ * @return False if the queue is full.
+ */
+template <typename T>
+bool BoundedQueue<T>::tryPush(T& value) {
+    size_t position = tail.load(memory_order_relaxed);
+
+    while (true) {
+        Cell& cell = cells[position & mask];
+        size_t sequence = cell.sequence.load(memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position);
+
+        if (difference == 0) {
+            if (tail.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                cell.value = move(value);
+                cell.sequence.store(position + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0) {
+            return false;
+        }
+        else {
+            position = tail.load(memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Pops a value if one is available.
+ *
+ * @param value Receives the value on success.
+ * @return False if the queue is empty.
+ */
+template <typename T>
+bool BoundedQueue<T>::tryPop(T& value) {
+    size_t position = head.load(memory_order_relaxed);
+
+    while (true) {
+        Cell& cell = cells[position & mask];
+        size_t sequence = cell.sequence.load(memory_order_acquire);
+        intptr_t difference = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1);
+
+        if (difference == 0) {
+            if (head.compare_exchange_weak(position, position + 1, memory_order_relaxed)) {
+                value = move(cell.value);
+                cell.sequence.store(position + mask + 1, memory_order_release);
+                return true;
+            }
+        }
+        else if (difference < 0) {
+            return false;
+        }
+        else {
+            position = head.load(memory_order_relaxed);
+        }
+    }
+}
+
+/**
+ * @brief Returns true unless the queue is certainly full.
+ */
+template <typename T>
+bool BoundedQueue<T>::mayPush() const {
+    size_t position = tail.load(memory_order_relaxed);
+    size_t sequence = cells[position & mask].sequence.load(memory_order_acquire);
+    return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position) >= 0;
+}
+
+/**
+ * @brief Returns true unless the queue is certainly empty.
+ */
+template <typename T>
+bool BoundedQueue<T>::mayPop() const {
+    size_t position = head.load(memory_order_relaxed);
+    size_t sequence = cells[position & mask].sequence.load(memory_order_acquire);
+    return static_cast<intptr_t>(sequence) - static_cast<intptr_t>(position + 1) >= 0;
+}
+
+/**
+ * @brief Sleeps until a condition holds or the queue is closed.
+ *
+ * The sleeper is counted before the condition is checked, and the other 
+ * side reads the count with a read-modify-write after its change. Both 
+ * touch the same counter, so whichever comes second sees the other's 
+ * work and a wakeup cannot be lost.
+ *
+ * @param ready The condition to wait for.
+ */
+template <typename T>
+template <typename Ready>
+void BoundedQueue<T>::sleepUntil(Ready ready) {
+    unique_lock<mutex> lock(sleepMutex);
+    sleepers.fetch_add(1, memory_order_acq_rel);
+    changed.wait(lock, [&]() { return closed.load(memory_order_acquire) || ready(); });
+    sleepers.fetch_sub(1, memory_order_relaxed);
+}
+
+/**
+ * @brief Wakes any thread sleeping in Push() or Pop() after a change.
+ */
+template <typename T>
+void BoundedQueue<T>::wakeSleepers() {
+    if (sleepers.fetch_add(0, memory_order_acq_rel) != 0) {
+        lock_guard<mutex> lock(sleepMutex);
+        changed.notify_all();
+    }
+}
+
+/**
+ * @brief Pushes a value, waiting while the queue is full.
+ *
+ * @param value The value to push.
+ * @return False if the queue was closed; the value is dropped.
+ */
+template <typename T>
+bool BoundedQueue<T>::Push(T value) {
+    for (unsigned attempt = 1; !tryPush(value); ++attempt) {
+        if (closed.load(memory_order_acquire)) {
+            return false;
+        }
+        if (attempt < QUEUE_SPIN_LIMIT) {
+            this_thread::yield();
+        }
+        else {
+            sleepUntil([this]() { return mayPush(); });
+        }
+    }
+    wakeSleepers();
+    return true;
+}
+
+/**
+ * @brief Pops a value, waiting while the queue is empty.
+ *
+ * @param value Receives the value.
+ * @return False once the queue is closed and drained.
+ */
+template <typename T>
+bool BoundedQueue<T>::Pop(T& value) {
+    for (unsigned attempt = 1; !tryPop(value); ++attempt) {
+        if (closed.load(memory_order_acquire)) {
+            // Values pushed just before the close are still delivered
+            if (!tryPop(value)) {
+                return false;
+            }
+            break;
+        }
+        if (attempt < QUEUE_SPIN_LIMIT) {
+            this_thread::yield();
+        }
+        else {
+            sleepUntil([this]() { return mayPop(); });
+        }
+    }
+    wakeSleepers();
+    return true;
+}
+
+/**
+ * @brief Closes the queue: later pushes fail and pops end once it is drained.
+ */
+template <typename T>
+void BoundedQueue<T>::Close() {
+    closed.store(true, memory_order_release);
+    lock_guard<mutex> lock(sleepMutex);
+    changed.notify_all();
+}
+
+/// Bytes the reader stage hands to a parser at a time (rounded to whole lines).
+constexpr size_t STREAM_BLOCK_BYTES = 1 << 20;
+
+/**
+ * @class CourseStreamDecoder
+ * @brief Reads the raw bytes of a course stream, decompressing it if needed.
+ *
+ * The first bytes are checked for a compression header. Gzip streams 
+ * (including several concatenated members) are inflated when the program 
+ * is built with zlib (define ABCU_WITH_ZLIB and link with -lz); otherwise, 
+ * and for zstd streams, the decoder fails with advice to decompress the 
+ * input before piping it in.
+ */
+class CourseStreamDecoder {
+
+    private:
+        istream& input;
+        string header;              /// Bytes read while sniffing, returned first
+        size_t headerPosition;
+#ifdef ABCU_WITH_ZLIB
+        bool gzip;
+        bool memberEnded;
+        z_stream inflater;
+        vector<char> compressed;
+#endif
+
+        size_t readRaw(char* out, size_t capacity);
+
+    public:
+        explicit CourseStreamDecoder(istream& input);
+        ~CourseStreamDecoder();
+
+        CourseStreamDecoder(const CourseStreamDecoder&) = delete;
+        CourseStreamDecoder& operator=(const CourseStreamDecoder&) = delete;
+
+        size_t Read(char* out, size_t capacity);
+};
+
+/**
+ * @brief Detects the stream's format.
+ *
+ * @param input The byte stream; read from its current position.
+ * @throws runtime_error if the stream is compressed in a format this build cannot read.
+ */
+CourseStreamDecoder::CourseStreamDecoder(istream& input) : input(input) {
+    headerPosition = 0;
+    header.resize(4);
+    input.read(&header[0], static_cast<streamsize>(header.size()));
+    header.resize(static_cast<size_t>(input.gcount()));
+
+    bool gzipMagic = header.size() >= 2 && header[0] == '\x1f' && header[1] == '\x8b';
+    bool zstdMagic = header.size() >= 4 && header.compare(0, 4, "\x28\xb5\x2f\xfd") == 0;
+
+    if (zstdMagic) {
+        throw runtime_error("Input is zstd-compressed; decompress it first (e.g. zstd -dc file | ...).");
+    }
+#ifdef ABCU_WITH_ZLIB
+    gzip = gzipMagic;
+    memberEnded = false;
+    inflater = {};
+    if (gzip) {
+        compressed.resize(STREAM_BLOCK_BYTES);
+        if (inflateInit2(&inflater, 15 + 16) != Z_OK) {  // 16: expect a gzip wrapper
+            throw runtime_error("Unable to start gzip decompression.");
+        }
+    }
+#else
+    if (gzipMagic) {
+        throw runtime_error("Input is gzip-compressed and this build has no zlib; decompress it first "
+                            "(e.g. gzip -dc file | ...) or rebuild with -DABCU_WITH_ZLIB -lz.");
+    }
+#endif
+}
+
+/**
+ * @brief Releases the decompressor.
+ */
+CourseStreamDecoder::~CourseStreamDecoder() {
+#ifdef ABCU_WITH_ZLIB
+    if (gzip) {
+        inflateEnd(&inflater);
+    }
+#endif
+}
+
+/**
+ * @brief Reads bytes as they appear in the stream, starting with the sniffed header.
+ *
+ * @return Number of bytes read; 0 at the end of the stream.
+ * @throws runtime_error if the stream fails.
+ */
+size_t CourseStreamDecoder::readRaw(char* out, size_t capacity) {
+    if (headerPosition < header.size()) {
+        size_t count = min(capacity, header.size() - headerPosition);
+        memcpy(out, header.data() + headerPosition, count);
+        headerPosition += count;
+        return count;
+    }
+
+    input.read(out, static_cast<streamsize>(capacity));
+    if (input.bad()) {
+        throw runtime_error("Data input failure before reaching the end of file.");
+    }
+    return static_cast<size_t>(input.gcount());
+}
+
+/**
+ * @brief Reads decoded bytes.
+ *
+ * @param out Destination buffer.
+ * @param capacity Size of the buffer.
+ * @return Number of bytes read; 0 at the end of the stream.
+ * @throws runtime_error if the stream fails or the compressed data is corrupt.
+ */
+size_t CourseStreamDecoder::Read(char* out, size_t capacity) {
+#ifdef ABCU_WITH_ZLIB
+    if (gzip) {
+        inflater.next_out = reinterpret_cast<Bytef*>(out);
+        inflater.avail_out = static_cast<uInt>(min<size_t>(capacity, numeric_limits<uInt>::max()));
+        uInt available = inflater.avail_out;
+
+        while (inflater.avail_out == available) {
+            if (inflater.avail_in == 0) {
+                size_t count = readRaw(compressed.data(), compressed.size());
+                if (count == 0) {
+                    if (!memberEnded) {
+                        throw runtime_error("Gzip input ended unexpectedly.");
+                    }
+                    return 0;
+                }
+                inflater.next_in = reinterpret_cast<Bytef*>(compressed.data());
+                inflater.avail_in = static_cast<uInt>(count);
+            }
+
+            // Another member follows the one that just ended
+            if (memberEnded) {
+                inflateReset(&inflater);
+                memberEnded = false;
+            }
+
+            int status = inflate(&inflater, Z_NO_FLUSH);
+            if (status == Z_STREAM_END) {
+                memberEnded = true;
+            }
+            else if (status != Z_OK && status != Z_BUF_ERROR) {
+                throw runtime_error("Gzip input is corrupt.");
+            }
+        }
+        return available - inflater.avail_out;
+    }
+#endif
+    return readRaw(out, capacity);
+}
+
+//============================================================================
+// Prerequisite Graph
+//============================================================================
+
+/**
+ * @class PrerequisiteGraph
+ * @brief Prerequisite relationships resolved to dense integer course IDs.
+ *
+ * Every course gets a small integer ID, and its resolved prerequisites and 
+ * dependents (the courses that list it) are stored as ID lists in 
+ * compressed sparse row form: one flat edge array per direction, with each 
+ * course's list a contiguous run in it. Walking dependencies is then a 
+ * series of array reads instead of a tree lookup per edge.
+ *
+ * Rebuild() numbers the courses in ID order and lays the rows out back to 
+ * back. Insert() and Remove() update the graph in place in time 
+ * proportional to the edges they touch: a row that shrinks is rewritten 
+ * where it is, and a row that grows is moved to the end of the edge array. 
+ * The space this leaves behind is reclaimed once it outweighs the live 
+ * edges and exceeds COMPACTION_MIN_GARBAGE, so small graphs are not 
+ * compacted on every few edits. IDs of removed courses are not reused until the next Rebuild().
+ *
+ * Prerequisites that name a course not in the catalog are remembered and 
+ * become edges as soon as that course is inserted.
+ *
+ * Course IDs are looked up through a linear-probing table of packed keys 
+ * rather than a node-based map, since Rebuild() does one lookup per 
+ * prerequisite in the catalog.
+ *
+ * The graph keeps its own copies of the course IDs, so it does not depend 
+ * on the tree after it is built. Apply each edit to both; the graph is not 
+ * thread-safe.
+ */
+class PrerequisiteGraph {
+
+    public:
+        static constexpr uint32_t NO_COURSE = numeric_limits<uint32_t>::max();
+        static constexpr size_t COMPACTION_MIN_GARBAGE = 4096;
+
+        /// A contiguous run of course IDs.
+        class EdgeList {
+            const uint32_t* first;
+            const uint32_t* last;
+        public:
+            EdgeList(const uint32_t* first, const uint32_t* last) : first(first), last(last) {}
+            const uint32_t* begin() const { return first; }
+            const uint32_t* end() const { return last; }
+            size_t size() const { return static_cast<size_t>(last - first); }
+            bool empty() const { return first == last; }
+        };
+
+    private:
+        /// One direction of the graph: row id is edges[start[id], start[id] + count[id]).
+        struct Adjacency {
+            vector<uint32_t> start;
+            vector<uint32_t> count;
+            vector<uint32_t> edges;
+            size_t garbage = 0;                 /// Edge slots no row refers to any more
+        };
+
+        /// Slot of the ID lookup table; a packed key lets most probes skip the string.
+        struct IdSlot {
+            CourseKey key;
+            uint32_t id;                        /// NO_COURSE if the slot is empty
+        };
+
+        deque<string> courseIds;                /// Course ID strings by ID
+        vector<bool> live;                      /// False once a course is removed
+        vector<IdSlot> idSlots;                 /// Linear-probing table of live IDs; size is a power of two
+        size_t liveCourses;
+        Adjacency forward;                      /// Course -> prerequisites
+        Adjacency reverse;                      /// Course -> dependents
+        unordered_map<string, vector<uint32_t>> unresolved;    /// Missing course ID -> courses listing it
+        size_t unresolvedCount;
+        uint64_t version;                       /// Incremented by every change
+
+        static EdgeList row(const Adjacency& adjacency, uint32_t id);
+        static void replaceRow(Adjacency& adjacency, uint32_t id, const uint32_t* first, size_t count);
+        static void addEdge(Adjacency& adjacency, uint32_t id, uint32_t target);
+        static void removeEdge(Adjacency& adjacency, uint32_t id, uint32_t target);
+        static void compact(Adjacency& adjacency);
+        size_t findIdSlot(const CourseKey& key, string_view courseId) const;
+        void placeId(uint32_t id);
+        void eraseIdSlot(size_t index);
+        void reserveIds(size_t courses);
+        uint32_t addCourse(string_view courseId);
+        void addUnresolved(string_view courseId, uint32_t dependent);
+
+    public:
+        PrerequisiteGraph();
+        explicit PrerequisiteGraph(const BinarySearchTree& tree);
+
+        void Rebuild(const BinarySearchTree& tree);
+        void Insert(const Course& course);
+        void Remove(const Course& course);
+
+        size_t Size() const;
+        size_t IdBound() const;
+        size_t EdgeCount() const;
+        uint64_t Version() const;
+        size_t UnresolvedCount() const;
+        template <typename Visitor>
+        void VisitUnresolved(Visitor&& visit) const;
+        vector<vector<uint32_t>> Cycles() const;
+        uint32_t IdOf(string_view courseId) const;
+        string_view CourseId(uint32_t id) const;
+        bool Contains(uint32_t id) const;
+        EdgeList Prerequisites(uint32_t id) const;
+        EdgeList Dependents(uint32_t id) const;
+};
+
+/**
+ * @brief Constructs an empty graph.
+ */
+PrerequisiteGraph::PrerequisiteGraph() {
+    liveCourses = 0;
+    unresolvedCount = 0;
+    version = 0;
+}
+
+/**
+ * @brief Constructs the graph of a tree's courses.
+ *
+ * @param tree The catalog to index.
+ */
+PrerequisiteGraph::PrerequisiteGraph(const BinarySearchTree& tree) : PrerequisiteGraph() {
+    Rebuild(tree);
+}
+
+/**
+ * @brief Returns a course's row in one direction.
+ */
+PrerequisiteGraph::EdgeList PrerequisiteGraph::row(const Adjacency& adjacency, uint32_t id) {
+    const uint32_t* first = adjacency.edges.data() + adjacency.start[id];
+    return EdgeList(first, first + adjacency.count[id]);
+}
+
+/**
+ * @brief Replaces a course's row, in place if it fits and at the end otherwise.
+ *
+ * @param adjacency The direction to edit.
+ * @param id The course whose row changes.
+ * @param first The new row; may point into the edge array itself.
+ * @param count Length of the new row.
+ */
+void PrerequisiteGraph::replaceRow(Adjacency& adjacency, uint32_t id, const uint32_t* first, size_t count) {
+    if (count <= adjacency.count[id]) {
+        copy(first, first + count, adjacency.edges.begin() + adjacency.start[id]);
+        adjacency.garbage += adjacency.count[id] - count;
+    }
+    else {
+        // Copy first: growing the edge array may move the source row
+        vector<uint32_t> rowCopy(first, first + count);
+        adjacency.garbage += adjacency.count[id];
+        adjacency.start[id] = static_cast<uint32_t>(adjacency.edges.size());
+        adjacency.edges.insert(adjacency.edges.end(), rowCopy.begin(), rowCopy.end());
+    }
+    adjacency.count[id] = static_cast<uint32_t>(count);
+
+    if (adjacency.garbage > adjacency.edges.size() / 2 && adjacency.garbage > COMPACTION_MIN_GARBAGE) {
+        compact(adjacency);
+    }
+}
+
+/**
+ * @brief Appends an edge to a course's row unless it is already there.
+ */
+void PrerequisiteGraph::addEdge(Adjacency& adjacency, uint32_t id, uint32_t target) {
+    EdgeList current = row(adjacency, id);
+    if (find(current.begin(), current.end(), target) != current.end()) {
+        return;
+    }
+
+    vector<uint32_t> grown(current.begin(), current.end());
+    grown.push_back(target);
+    replaceRow(adjacency, id, grown.data(), grown.size());
+}
+
+/**
+ * @brief Removes an edge from a course's row.
+ */
+void PrerequisiteGraph::removeEdge(Adjacency& adjacency, uint32_t id, uint32_t target) {
+    EdgeList current = row(adjacency, id);
+    vector<uint32_t> shrunk;
+    shrunk.reserve(current.size());
+    remove_copy(current.begin(), current.end(), back_inserter(shrunk), target);
+    replaceRow(adjacency, id, shrunk.data(), shrunk.size());
+}
+
+/**
+ * @brief Lays the rows out back to back again, dropping unused edge slots.
+ */
+void PrerequisiteGraph::compact(Adjacency& adjacency) {
+    vector<uint32_t> edges;
+    edges.reserve(adjacency.edges.size() - adjacency.garbage);
+
+    for (size_t id = 0; id < adjacency.start.size(); ++id) {
+        EdgeList current = row(adjacency, static_cast<uint32_t>(id));
+        adjacency.start[id] = static_cast<uint32_t>(edges.size());
+        edges.insert(edges.end(), current.begin(), current.end());
+    }
+    adjacency.edges.swap(edges);
+    adjacency.garbage = 0;
+}
+
+/**
+ * @brief Finds the lookup table slot holding a course ID, or the empty slot 
+ * that ends its probe sequence.
+ *
+ * @param key Packed course ID.
+ * @param courseId The course ID, compared only when the packed keys tie on 
+ *                 an ID of PACKED_CHARS or more characters.
+ * @return Index of the slot.
+ */
+size_t PrerequisiteGraph::findIdSlot(const CourseKey& key, string_view courseId) const {
+    size_t mask = idSlots.size() - 1;
+    size_t index = hashCourseKey(key) & mask;
+
+    while (idSlots[index].id != NO_COURSE) {
+        const IdSlot& slot = idSlots[index];
+        if (slot.key.high == key.high && slot.key.low == key.low &&
+            (courseId.size() < CourseKey::PACKED_CHARS || courseIds[slot.id] == courseId)) {
+            return index;
+        }
+        index = (index + 1) & mask;
+    }
+    return index;
+}
+
+/**
+ * @brief Adds a course ID that is not yet in the lookup table.
+ */
+void PrerequisiteGraph::placeId(uint32_t id) {
+    CourseKey key = CourseKey::Pack(courseIds[id]);
+    size_t index = findIdSlot(key, courseIds[id]);
+    idSlots[index] = { key, id };
+}
+
+/**
+ * @brief Empties a lookup table slot, shifting later entries of the same 
+ * probe run back so that lookups never stop early.
+ */
+void PrerequisiteGraph::eraseIdSlot(size_t index) {
+    size_t mask = idSlots.size() - 1;
+    size_t hole = index;
+
+    for (size_t next = (hole + 1) & mask; idSlots[next].id != NO_COURSE; next = (next + 1) & mask) {
+        size_t home = hashCourseKey(idSlots[next].key) & mask;
+
+        // Move the entry back unless its home lies cyclically in (hole, next]
+        if (((next - home) & mask) >= ((next - hole) & mask)) {
+            idSlots[hole] = idSlots[next];
+            hole = next;
+        }
+    }
+    idSlots[hole].id = NO_COURSE;
+}
+
+/**
+ * @brief Grows the lookup table to hold a number of live courses at no 
+ * more than half load.
+ */
+void PrerequisiteGraph::reserveIds(size_t courses) {
+    size_t slotCount = max<size_t>(idSlots.size(), 16);
+    while (slotCount < courses * 2) {
+        slotCount *= 2;
+    }
+    if (slotCount == idSlots.size()) {
+        return;
+    }
+
+    idSlots.assign(slotCount, { { 0, 0 }, NO_COURSE });
+    for (uint32_t id = 0; id < courseIds.size(); ++id) {
+        if (live[id]) {
+            placeId(id);
+        }
+    }
+}
+
+/**
+ * @brief Gives a course the next ID and empty rows.
+ *
+ * @return The new ID.
+ */
+uint32_t PrerequisiteGraph::addCourse(string_view courseId) {
+    if (courseIds.size() >= NO_COURSE) {
+        throw length_error("Too many courses for the prerequisite graph.");
+    }
+
+    uint32_t id = static_cast<uint32_t>(courseIds.size());
+    courseIds.emplace_back(courseId);
+    live.push_back(true);
+    reserveIds(liveCourses + 1);
+    placeId(id);
+    ++liveCourses;
+
+    for (Adjacency* adjacency : { &forward, &reverse }) {
+        adjacency->start.push_back(static_cast<uint32_t>(adjacency->edges.size()));
+        adjacency->count.push_back(0);
+    }
+    return id;
+}
+
+/**
+ * @brief Remembers that a course lists a prerequisite that is not in the catalog.
+ *
+ * A course's references are added together, so a repeat can only be the 
+ * last entry; checking just that keeps widely listed missing courses linear.
+ */
+void PrerequisiteGraph::addUnresolved(string_view courseId, uint32_t dependent) {
+    vector<uint32_t>& dependents = unresolved[string(courseId)];
+    if (dependents.empty() || dependents.back() != dependent) {
+        dependents.push_back(dependent);
+        ++unresolvedCount;
+    }
+}
+
+/**
+ * @brief Discards the graph and builds it again from a tree.
+ *
+ * Courses are numbered in ID order, so IDs are dense and rows are laid out 
+ * in the same order as the catalog.
+ *
+ * @param tree The catalog to index.
+ */
+void PrerequisiteGraph::Rebuild(const BinarySearchTree& tree) {
+    idSlots.clear();
+    courseIds.clear();
+    live.clear();
+    liveCourses = 0;
+    forward = Adjacency();
+    reverse = Adjacency();
+    unresolved.clear();
+    unresolvedCount = 0;
+    ++version;
+
+    reserveIds(tree.Size());
+    live.reserve(tree.Size());
+    tree.VisitInOrder([this](const Course& course) {
+        addCourse(course.courseId);
+    });
+
+    // Forward rows in course order, deduplicating repeated prerequisites
+    uint32_t id = 0;
+    tree.VisitInOrder([this, &id](const Course& course) {
+        forward.start[id] = static_cast<uint32_t>(forward.edges.size());
+
+        for (const pmr::string& prerequisite : course.prerequisites) {
+            uint32_t target = IdOf(prerequisite);
+            auto rowFirst = forward.edges.begin() + forward.start[id];
+
+            if (target == NO_COURSE) {
+                addUnresolved(prerequisite, id);
+            }
+            else if (find(rowFirst, forward.edges.end(), target) == forward.edges.end()) {
+                forward.edges.push_back(target);
+            }
+        }
+        forward.count[id] = static_cast<uint32_t>(forward.edges.size() - forward.start[id]);
+        ++id;
+    });
+
+    // Reverse rows by counting sort over the forward edges
+    size_t courseCount = courseIds.size();
+    for (uint32_t target : forward.edges) {
+        ++reverse.count[target];
+    }
+    uint32_t offset = 0;
+    for (size_t course = 0; course < courseCount; ++course) {
+        reverse.start[course] = offset;
+        offset += reverse.count[course];
+    }
+    reverse.edges.resize(forward.edges.size());
+
+    vector<uint32_t> filled(courseCount, 0);
+    for (uint32_t course = 0; course < courseCount; ++course) {
+        for (uint32_t target : row(forward, course)) {
+            reverse.edges[reverse.start[target] + filled[target]++] = course;
+        }
+    }
+}
+
+/**
+ * @brief Adds a course that was just inserted into the catalog.
+ *
+ * Its prerequisites become edges, and courses that were waiting for it 
+ * (listing it before it existed) gain an edge to it. Does nothing if the 
+ * course is already in the graph.
+ *
+ * @param course The inserted course.
+ */
+void PrerequisiteGraph::Insert(const Course& course) {
+    if (IdOf(course.courseId) != NO_COURSE) {
+        return;
+    }
+    uint32_t id = addCourse(course.courseId);
+    ++version;
+
+    vector<uint32_t> targets;
+    for (const pmr::string& prerequisite : course.prerequisites) {
+        uint32_t target = IdOf(prerequisite);
+
+        if (target == NO_COURSE) {
+            addUnresolved(prerequisite, id);
+        }
+        else if (find(targets.begin(), targets.end(), target) == targets.end()) {
+            targets.push_back(target);
+            addEdge(reverse, target, id);
+        }
+    }
+    replaceRow(forward, id, targets.data(), targets.size());
+
+    // Resolve references made before the course existed
+    auto waiting = unresolved.find(string(course.courseId));
+    if (waiting != unresolved.end()) {
+        for (uint32_t dependent : waiting->second) {
+            addEdge(forward, dependent, id);
+            addEdge(reverse, id, dependent);
+        }
+        unresolvedCount -= waiting->second.size();
+        unresolved.erase(waiting);
+    }
+}
+
+/**
+ * @brief Removes a course that is about to be removed from the catalog.
+ *
+ * Courses that list it keep the reference as an unresolved one, so the 
+ * edges come back if it is inserted again.
+ *
+ * @param course The course being removed (read before the tree frees it).
+ */
+void PrerequisiteGraph::Remove(const Course& course) {
+    uint32_t id = IdOf(course.courseId);
+    if (id == NO_COURSE) {
+        return;
+    }
+    ++version;
+
+    for (uint32_t target : vector<uint32_t>(row(forward, id).begin(), row(forward, id).end())) {
+        removeEdge(reverse, target, id);
+    }
+    for (uint32_t dependent : vector<uint32_t>(row(reverse, id).begin(), row(reverse, id).end())) {
+        removeEdge(forward, dependent, id);
+        addUnresolved(course.courseId, dependent);
+    }
+
+    // Drop the course's own unresolved references
+    for (const pmr::string& prerequisite : course.prerequisites) {
+        auto waiting = unresolved.find(string(prerequisite));
+        if (waiting == unresolved.end()) {
+            continue;
+        }
+        vector<uint32_t>& dependents = waiting->second;
+        auto found = find(dependents.begin(), dependents.end(), id);
+        if (found != dependents.end()) {
+            dependents.erase(found);
+            --unresolvedCount;
+        }
+        if (dependents.empty()) {
+            unresolved.erase(waiting);
+        }
+    }
+
+    replaceRow(forward, id, nullptr, 0);
+    replaceRow(reverse, id, nullptr, 0);
+    eraseIdSlot(findIdSlot(CourseKey::Pack(courseIds[id]), courseIds[id]));
+    live[id] = false;
+    --liveCourses;
+}
+
+/**
+ * @brief Returns the number of courses in the graph.
+ */
+size_t PrerequisiteGraph::Size() const {
+    return liveCourses;
+}
+
+/**
+ * @brief Returns one more than the largest ID handed out, for sizing per-course arrays.
+ */
+size_t PrerequisiteGraph::IdBound() const {
+    return courseIds.size();
+}
+
+/**
+ * @brief Returns the number of resolved prerequisite edges.
+ */
+size_t PrerequisiteGraph::EdgeCount() const {
+    return forward.edges.size() - forward.garbage;
+}
+
+/**
+ * @brief Returns a counter that changes whenever the graph does, for invalidating caches.
+ */
+uint64_t PrerequisiteGraph::Version() const {
+    return version;
+}
+
+/**
+ * @brief Returns the number of prerequisite references to courses not in the catalog.
+ */
+size_t PrerequisiteGraph::UnresolvedCount() const {
+    return unresolvedCount;
+}
+
+/**
+ * @brief Calls visit(missingId, dependents) for each course ID that is 
+ * listed as a prerequisite but not in the catalog, in no particular order.
+ *
+ * @param visit Receives the missing ID and the IDs of the courses listing it.
+ */
+template <typename Visitor>
+void PrerequisiteGraph::VisitUnresolved(Visitor&& visit) const {
+    for (const auto& [courseId, dependents] : unresolved) {
+        visit(string_view(courseId), dependents);
+    }
+}
+
+/**
+ * @brief Finds every prerequisite cycle.
+ *
+ * Runs Tarjan's strongly connected components algorithm over the 
+ * prerequisite edges in O(V + E), with explicit stacks so that long 
+ * prerequisite chains cannot overflow the call stack.
+ *
+ * @return One entry per cycle: the courses in a strongly connected 
+ *         component of two or more courses, or a course that lists itself.
+ */
+vector<vector<uint32_t>> PrerequisiteGraph::Cycles() const {
+    size_t courseCount = courseIds.size();
+    vector<uint32_t> order(courseCount, NO_COURSE);    /// Discovery order
+    vector<uint32_t> lowLink(courseCount, 0);
+    vector<bool> onStack(courseCount, false);
+    vector<uint32_t> component;                        /// Tarjan's stack of unassigned courses
+    vector<pair<uint32_t, uint32_t>> path;             /// (course, next edge to follow)
+    vector<vector<uint32_t>> cycles;
+    uint32_t discovered = 0;
+
+    auto discover = [&](uint32_t course) {
+        order[course] = lowLink[course] = discovered++;
+        component.push_back(course);
+        onStack[course] = true;
+        path.emplace_back(course, 0);
+    };
+
+    for (uint32_t root = 0; root < courseCount; ++root) {
+        if (!live[root] || order[root] != NO_COURSE) {
+            continue;
+        }
+        discover(root);
+
+        while (!path.empty()) {
+            uint32_t course = path.back().first;
+            EdgeList prerequisites = row(forward, course);
+
+            if (path.back().second < prerequisites.size()) {
+                uint32_t next = prerequisites.begin()[path.back().second++];
+                if (order[next] == NO_COURSE) {
+                    discover(next);
+                }
+                else if (onStack[next]) {
+                    lowLink[course] = min(lowLink[course], order[next]);
+                }
+                continue;
+            }
+
+            path.pop_back();
+            if (!path.empty()) {
+                uint32_t parent = path.back().first;
+                lowLink[parent] = min(lowLink[parent], lowLink[course]);
+            }
+            if (lowLink[course] != order[course]) {
+                continue;
+            }
+
+            // course is the root of a component; everything above it on the stack belongs to it
+            auto first = find(component.rbegin(), component.rend(), course).base() - 1;
+            vector<uint32_t> members(first, component.end());
+            component.erase(first, component.end());
+            for (uint32_t member : members) {
+                onStack[member] = false;
+            }
+
+            if (members.size() > 1 || find(prerequisites.begin(), prerequisites.end(), course) != prerequisites.end()) {
+                cycles.push_back(move(members));
+            }
+        }
+    }
+    return cycles;
+}
+
+/**
+ * @brief Returns a course's ID, or NO_COURSE if it is not in the graph.
+ */
+uint32_t PrerequisiteGraph::IdOf(string_view courseId) const {
+    if (idSlots.empty()) {
+        return NO_COURSE;
+    }
+    return idSlots[findIdSlot(CourseKey::Pack(courseId), courseId)].id;
+}
+
+/**
+ * @brief Returns the course ID string of an ID; empty for a removed course.
+ */
+string_view PrerequisiteGraph::CourseId(uint32_t id) const {
+    return live[id] ? string_view(courseIds[id]) : string_view();
+}
+
+/**
+ * @brief Checks whether an ID belongs to a course still in the graph.
+ */
+bool PrerequisiteGraph::Contains(uint32_t id) const {
+    return id < live.size() && live[id];
+}
+
+/**
+ * @brief Returns the IDs of a course's prerequisites that are in the catalog.
+ */
+PrerequisiteGraph::EdgeList PrerequisiteGraph::Prerequisites(uint32_t id) const {
+    return row(forward, id);
+}
+
+/**
+ * @brief Returns the IDs of the courses that list a course as a prerequisite.
+ */
+PrerequisiteGraph::EdgeList PrerequisiteGraph::Dependents(uint32_t id) const {
+    return row(reverse, id);
+}
+
+/**
+ * @class PrerequisiteClosure
+ * @brief Answers "every course that must come before this one" over a PrerequisiteGraph.
+ *
+ * ComputeAll() finds the closures of all courses at once. Courses are 
+ * grouped into levels by topological order, so that every prerequisite of 
+ * a course is on an earlier level. A course's closure, stored as a bitset 
+ * row over all course IDs, is then the OR of its prerequisites' rows plus 
+ * their own bits. The OR runs a vector register at a time, and the courses 
+ * of a level are split across threads since none of them reads another's 
+ * row. Each row is also zeroed by the thread that fills it, so the 
+ * matrix's pages are first touched in parallel. A level's work is its 
+ * courses plus their prerequisite edges, times the row length, so a level 
+ * is split once it has CLOSURE_PARALLEL_WORDS matrix words per thread, 
+ * however few courses it holds. Courses on or after a prerequisite cycle have no topological 
+ * position and are filled in by a plain search instead.
+ *
+ * The matrix needs IdBound() squared bits, so catalogs too large for 
+ * MATRIX_BYTE_LIMIT skip it; Of() then searches the graph per course. 
+ * Either way, answers are cached until the graph changes.
+ *
+ * Of() starts out searching, which is cheapest when closures are small or 
+ * only a few courses are asked about. After CLOSURE_SAMPLE_SEARCHES 
+ * searches, and again each time the count doubles, it checks how much of 
+ * the catalog they reached on average; if that is at least 
+ * 1/CLOSURE_DENSITY_DIVISOR of it, searching every course would cost more 
+ * than the matrix, so it builds the matrix and answers the rest from it. 
+ * That build can happen during an interactive query, so it is capped at 
+ * IMPLICIT_MATRIX_BYTE_LIMIT rather than MATRIX_BYTE_LIMIT; larger 
+ * catalogs keep searching unless ComputeAll() is called explicitly.
+ *
+ * Impact() answers the opposite question, "every course that depends on 
+ * this one", by walking the graph's dependent edges. It reads only the 
+ * courses it returns and their edges, so retiring a course can be checked 
+ * without scanning the catalog.
+ */
+class PrerequisiteClosure {
+
+    public:
+        static constexpr size_t MATRIX_BYTE_LIMIT = size_t(1) << 30;
+        static constexpr size_t IMPLICIT_MATRIX_BYTE_LIMIT = size_t(1) << 25;
+        static constexpr size_t CLOSURE_SAMPLE_SEARCHES = 64;
+        static constexpr size_t CLOSURE_DENSITY_DIVISOR = 256;
+        static constexpr size_t CLOSURE_PARALLEL_WORDS = size_t(1) << 16;
+
+    private:
+        const PrerequisiteGraph& graph;
+        uint64_t version;                       /// Graph version the matrix and cache belong to
+        size_t words;                           /// 64-bit words per matrix row
+        unique_ptr<uint64_t[]> matrix;          /// Row per course ID; null if not computed
+        unordered_map<uint32_t, vector<uint32_t>> cache;
+        unordered_map<uint32_t, vector<uint32_t>> impactCache;
+        vector<uint32_t> visitedBy;             /// Search marks, reset by bumping searchMark
+        uint32_t searchMark;
+        size_t sampledSearches;                 /// Searches by Of() since the graph last changed
+        size_t sampledReach;                    /// Courses those searches reached in total
+        size_t splitLevels;                     /// Levels the last ComputeAll() ran on several threads
+
+        void discardIfStale();
+        vector<uint32_t> search(uint32_t id, bool downstream = false);
+        static void orRow(uint64_t* target, const uint64_t* source, size_t words);
+
+    public:
+        explicit PrerequisiteClosure(const PrerequisiteGraph& graph);
+
+        bool ComputeAll(unsigned threads = 0, size_t byteLimit = MATRIX_BYTE_LIMIT);
+        size_t SplitLevels() const;
+        const vector<uint32_t>& Of(uint32_t id);
+        const vector<uint32_t>& Impact(uint32_t id);
+};
+
+/**
+ * @brief Constructs an empty closure over a graph.
+ *
+ * @param graph The graph to answer queries about; must outlive this object.
+ */
+PrerequisiteClosure::PrerequisiteClosure(const PrerequisiteGraph& graph) : graph(graph) {
+    version = graph.Version();
+    words = 0;
+    searchMark = 0;
+    sampledSearches = 0;
+    sampledReach = 0;
+    splitLevels = 0;
+}
+
+/**
+ * @brief Drops the matrix and cached answers if the graph has changed since.
+ */
+void PrerequisiteClosure::discardIfStale() {
+    if (version != graph.Version()) {
+        version = graph.Version();
+        matrix.reset();
+        cache.clear();
+        impactCache.clear();
+        sampledSearches = 0;
+        sampledReach = 0;
+    }
+}
+
+/**
+ * @brief ORs one bitset row into another.
+ *
+ * @param target Row to update.
+ * @param source Row to merge in.
+ * @param words Length of both rows in 64-bit words.
+ */
+void PrerequisiteClosure::orRow(uint64_t* target, const uint64_t* source, size_t words) {
+    size_t i = 0;
+#if defined(ABCU_USE_AVX2)
+    for (; i + 4 <= words; i += 4) {
+        __m256i merged = _mm256_or_si256(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(target + i)),
+                                         _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i)));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(target + i), merged);
+    }
+#elif defined(ABCU_USE_SSE2)
+    for (; i + 2 <= words; i += 2) {
+        __m128i merged = _mm_or_si128(_mm_loadu_si128(reinterpret_cast<const __m128i*>(target + i)),
+                                      _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + i)));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(target + i), merged);
+    }
+#endif
+    for (; i < words; ++i) {
+        target[i] |= source[i];
+    }
+}
+
+/**
+ * @brief Collects a course's closure by walking the graph.
+ *
+ * @param id The course.
+ * @param downstream True to follow dependent edges instead of prerequisite edges.
+ * @return IDs of every course reached, ascending.
+ */
+vector<uint32_t> PrerequisiteClosure::search(uint32_t id, bool downstream) {
+    if (visitedBy.size() < graph.IdBound() || searchMark == numeric_limits<uint32_t>::max()) {
+        visitedBy.assign(graph.IdBound(), 0);
+        searchMark = 0;
+    }
+    ++searchMark;
+
+    vector<uint32_t> reached;
+    vector<uint32_t> pending = { id };
+    while (!pending.empty()) {
+        uint32_t course = pending.back();
+        pending.pop_back();
+
+        for (uint32_t next : downstream ? graph.Dependents(course) : graph.Prerequisites(course)) {
+            if (visitedBy[next] != searchMark) {
+                visitedBy[next] = searchMark;
+                reached.push_back(next);
+                pending.push_back(next);
+            }
+        }
+    }
+    sort(reached.begin(), reached.end());
+    return reached;
+}
+
+/**
+ * @brief Computes the closure of every course.
+ *
+ * @param threads Number of threads to use; 0 uses one per hardware thread.
+ * @param byteLimit Largest matrix to allocate, in bytes.
+ * @return False if the catalog is too large for the matrix; queries then 
+ *         fall back to per-course searches.
+ */
+bool PrerequisiteClosure::ComputeAll(unsigned threads, size_t byteLimit) {
+    discardIfStale();
+    matrix.reset();
+    splitLevels = 0;
+
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    size_t courseCount = graph.IdBound();
+    words = (courseCount + 63) / 64;
+    if (words != 0 && courseCount > byteLimit / sizeof(uint64_t) / words) {
+        return false;
+    }
+    // Rows are zeroed as they are filled, on the thread that fills them
+    matrix.reset(new uint64_t[courseCount * words]);
+
+    // Kahn's algorithm: a course's level is one more than its deepest prerequisite's
+    vector<uint32_t> remaining(courseCount, 0);
+    vector<uint32_t> level(courseCount, 0);
+    vector<vector<uint32_t>> levels;
+    vector<uint32_t> ready;
+    vector<bool> placed(courseCount, false);
+
+    for (uint32_t id = 0; id < courseCount; ++id) {
+        if (graph.Contains(id)) {
+            remaining[id] = static_cast<uint32_t>(graph.Prerequisites(id).size());
+            if (remaining[id] == 0) {
+                ready.push_back(id);
+            }
+        }
+    }
+    while (!ready.empty()) {
+        uint32_t course = ready.back();
+        ready.pop_back();
+        placed[course] = true;
+
+        if (levels.size() <= level[course]) {
+            levels.resize(level[course] + 1);
+        }
+        levels[level[course]].push_back(course);
+
+        for (uint32_t dependent : graph.Dependents(course)) {
+            level[dependent] = max(level[dependent], level[course] + 1);
+            if (--remaining[dependent] == 0) {
+                ready.push_back(dependent);
+            }
+        }
+    }
+
+    auto fillRows = [this](const vector<uint32_t>& courses, size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            uint64_t* row = matrix.get() + courses[i] * words;
+            fill_n(row, words, 0);
+            for (uint32_t prerequisite : graph.Prerequisites(courses[i])) {
+                orRow(row, matrix.get() + prerequisite * words, words);
+                row[prerequisite / 64] |= uint64_t(1) << (prerequisite % 64);
+            }
+        }
+    };
+
+    vector<size_t> edgesBefore;
+    for (size_t depth = 0; depth < levels.size(); ++depth) {
+        const vector<uint32_t>& courses = levels[depth];
+
+        // Zeroing a row and each prerequisite edge touch one full row apiece
+        edgesBefore.assign(1, 0);
+        for (uint32_t course : courses) {
+            edgesBefore.push_back(edgesBefore.back() + 1 + graph.Prerequisites(course).size());
+        }
+        size_t chunks = min<size_t>(threads, edgesBefore.back() * words / CLOSURE_PARALLEL_WORDS);
+
+        if (chunks < 2) {
+            fillRows(courses, 0, courses.size());
+            continue;
+        }
+
+        // Cut where each chunk has an equal share of the work
+        vector<future<void>> parts;
+        size_t first = 0;
+        for (size_t i = 1; i <= chunks; ++i) {
+            size_t last = courses.size();
+            if (i < chunks) {
+                size_t share = edgesBefore.back() * i / chunks;
+                last = lower_bound(edgesBefore.begin(), edgesBefore.end(), share) - edgesBefore.begin();
+            }
+            parts.push_back(async(launch::async, fillRows, cref(courses), first, last));
+            first = last;
+        }
+        for (future<void>& part : parts) {
+            part.get();
+        }
+        ++splitLevels;
+    }
+
+    // Courses on or downstream of a cycle, and unused IDs
+    for (uint32_t id = 0; id < courseCount; ++id) {
+        if (!placed[id]) {
+            uint64_t* row = matrix.get() + id * words;
+            fill_n(row, words, 0);
+            for (uint32_t reached : graph.Contains(id) ? search(id) : vector<uint32_t>()) {
+                row[reached / 64] |= uint64_t(1) << (reached % 64);
+            }
+        }
+    }
+    return true;
+}
+
+/**
+ * @brief Returns how many levels the last ComputeAll() split across threads.
+ *
+ * @return Number of levels filled by more than one thread.
+ */
+size_t PrerequisiteClosure::SplitLevels() const {
+    return splitLevels;
+}
+
+/**
+ * @brief Returns every course that must be taken before a course.
+ *
+ * @param id The course.
+ * @return IDs of its direct and indirect prerequisites, ascending. Valid 
+ *         until the next call that finds the graph changed.
+ */
+const vector<uint32_t>& PrerequisiteClosure::Of(uint32_t id) {
+    discardIfStale();
+
+    auto cached = cache.find(id);
+    if (cached != cache.end()) {
+        return cached->second;
+    }
+
+    vector<uint32_t> closure;
+    if (matrix) {
+        const uint64_t* row = matrix.get() + id * words;
+        for (size_t word = 0; word < words; ++word) {
+            for (uint64_t bits = row[word]; bits != 0; bits &= bits - 1) {
+                closure.push_back(static_cast<uint32_t>(word * 64 + countTrailingZeros(bits)));
+            }
+        }
+    }
+    else {
+        closure = search(id);
+        sampledReach += closure.size();
+
+        // Dense enough that the matrix beats searching the rest one by one
+        ++sampledSearches;
+        if (sampledSearches >= CLOSURE_SAMPLE_SEARCHES && (sampledSearches & (sampledSearches - 1)) == 0 &&
+            sampledReach * CLOSURE_DENSITY_DIVISOR >= sampledSearches * graph.IdBound()) {
+            ComputeAll(0, IMPLICIT_MATRIX_BYTE_LIMIT);
+        }
+    }
+    return cache.emplace(id, move(closure)).first->second;
+}
+
+/**
+ * @brief Returns every course that depends on a course, directly or through 
+ * other courses.
+ *
+ * @param id The course.
+ * @return IDs of the courses affected if it were retired, ascending. Valid 
+ *         until the next call that finds the graph changed.
+ */
+const vector<uint32_t>& PrerequisiteClosure::Impact(uint32_t id) {
+    discardIfStale();
+
+    auto cached = impactCache.find(id);
+    if (cached != impactCache.end()) {
+        return cached->second;
+    }
+    return impactCache.emplace(id, search(id, true)).first->second;
+}
+
+//============================================================================
+// Static Methods for Testing
+//============================================================================
+
+/// Number of courses shown per page by the paged course list.
+constexpr size_t COURSES_PER_PAGE = 50;
+
+/**
+ * @brief Displays a single course and its prerequisites.
+ *
+ * Outputs the course ID, name, and all prerequisites to standard output.
+ *
+ * @param course The course to display (a Course or a MappedCatalog::CourseView).
+ */
+template <typename CourseType>
+void displayCourse(const CourseType& course) {
+    cout << course.courseId << ", " << course.name << endl;
+
+    //If there are no prerequisites
+    if (course.prerequisites.empty()) {
+        cout << "Prerequisites: None";
+    }
+    //Else
+    else {
+        cout << "Prerequisites: ";
+        //For Each Prerequisite
+        for (size_t i = 0; i < course.prerequisites.size(); i++) {
+            //Display Prerequisite
+            cout << course.prerequisites.at(i);
+            //If more than one prerequisite in the vector and not the last element
+            if (course.prerequisites.size() > 1 && course.prerequisites.size() - 1 != i) {
+                cout << ", ";
+            }
+        }
+    }
+    cout << endl;
+}
+
+/**
+ * @brief Displays every course that must be taken before a course, when 
+ * that goes beyond its direct prerequisites.
+ *
+ * @param closure Closure over the catalog's prerequisite graph.
+ * @param graph The graph the closure was built on.
+ * @param course The course whose prerequisites were just displayed.
+ */
+void displayAllPrerequisites(PrerequisiteClosure& closure, const PrerequisiteGraph& graph, const Course& course) {
+    uint32_t id = graph.IdOf(course.courseId);
+    if (id == PrerequisiteGraph::NO_COURSE || closure.Of(id).size() <= graph.Prerequisites(id).size()) {
+        return;
+    }
+
+    vector<string_view> courseIds;
+    for (uint32_t prerequisite : closure.Of(id)) {
+        courseIds.push_back(graph.CourseId(prerequisite));
+    }
+    sort(courseIds.begin(), courseIds.end());
+
+    cout << "All prerequisites: ";
+    for (size_t i = 0; i < courseIds.size(); i++) {
+        cout << (i == 0 ? "" : ", ") << courseIds[i];
+    }
+    cout << endl;
+}
+
+/**
+ * @brief Displays the courses that list a course as a prerequisite, and 
+ * every course that depends on it through them.
+ *
+ * @param closure Closure over the catalog's prerequisite graph.
+ * @param graph The graph the closure was built on.
+ * @param courseId The course to check.
+ */
+void displayImpact(PrerequisiteClosure& closure, const PrerequisiteGraph& graph, string_view courseId) {
+    uint32_t id = graph.IdOf(courseId);
+    if (id == PrerequisiteGraph::NO_COURSE || graph.Dependents(id).empty()) {
+        cout << "Required by: None" << endl;
+        return;
+    }
+
+    for (bool transitive : { false, true }) {
+        vector<string_view> courseIds;
+        if (transitive) {
+            for (uint32_t dependent : closure.Impact(id)) {
+                courseIds.push_back(graph.CourseId(dependent));
+            }
+        }
+        else {
+            for (uint32_t dependent : graph.Dependents(id)) {
+                courseIds.push_back(graph.CourseId(dependent));
+            }
+        }
+        if (transitive && courseIds.size() == graph.Dependents(id).size()) {
+            break;
+        }
+        sort(courseIds.begin(), courseIds.end());
+
+        cout << (transitive ? "All dependent courses: " : "Required by: ");
+        for (size_t i = 0; i < courseIds.size(); i++) {
+            cout << (i == 0 ? "" : ", ") << courseIds[i];
+        }
+        cout << endl;
+    }
+}
+
+/**
+ * @brief Prints one page of the course list.
+ *
+ * @param courseList The tree to list.
+ * @param page One-based page number.
+ */
+void displayCoursePage(const BinarySearchTree& courseList, size_t page) {
+    size_t pageCount = (courseList.Size() + COURSES_PER_PAGE - 1) / COURSES_PER_PAGE;
+
+    if (page < 1 || page > pageCount) {
+        cout << "Page " << page << " does not exist; there are " << pageCount << " page(s)." << endl;
+        return;
+    }
+
+    cout << "Page " << page << " of " << pageCount << ":" << endl;
+    cout << endl; // Empty line for readability
+
+    courseList.VisitPage(page - 1, COURSES_PER_PAGE, [](const Course& course) {
+        cout << course.courseId << ", " << course.name << endl;
+    });
+}
+
+/**
+ * @brief Prints one line per course returned by a range or prefix scan.
+ *
+ * @param courseList The catalog to scan (a BinarySearchTree or a MappedCatalog).
+ * @param first Smallest course ID, or the prefix when last is empty.
+ * @param last Largest course ID; empty for a prefix scan.
+ */
+template <typename Catalog>
+void displayCourseScan(const Catalog& courseList, string_view first, string_view last) {
+    auto print = [](const auto& course) {
+        cout << course.courseId << ", " << course.name << endl;
+    };
+    size_t count = last.empty() ? courseList.PrefixScan(first, print)
+                                : courseList.RangeScan(first, last, print);
+
+    if (count == 0) {
+        cout << "No courses found." << endl;
+    }
+    else {
+        cout << count << " course(s) found." << endl;
+    }
+}
+
+/**
+ * @brief Splits a CSV line into tokens based on a delimiter.
+ *
+ * @param line The line to split.
+ * @param delimiter The delimiter character (e.g., ',').
+ * @param fields Cleared, then filled with views into line.
+ */
+void splitLine(string_view line, char delimiter, vector<string_view>& fields) {
+    CsvTokenizer(line, delimiter).NextRow(fields);
+}
+
+/**
+ * @brief Reads a byte range of a file into memory.
+ *
+ * Each call opens its own stream, so several ranges can be read at once.
+ *
+ * @param filePath Path to the file.
+ * @param offset First byte to read.
+ * @param out Destination for the bytes.
+ * @param length Number of bytes to read.
+ * @throws runtime_error if the range cannot be read in full.
+ */
+void readFileRange(const string& filePath, uint64_t offset, char* out, size_t length) {
+    ifstream inCourseFS(filePath, ios::binary);
+    inCourseFS.seekg(static_cast<streamoff>(offset));
+    inCourseFS.read(out, static_cast<streamsize>(length));
+
+    // Stream failed before EOF (e.g., corrupted input)
+    if (!inCourseFS || inCourseFS.gcount() != static_cast<streamsize>(length)) {
+        throw runtime_error("Data input failure before reaching the end of file.");
+    }
+}
+
+/**
+ * @brief Parses CSV rows into courses.
+ *
+ * @param text Whole lines of CSV text.
+ * @param alloc Allocator for the courses' strings.
+ * @param courses Receives one course per valid line, in file order.
+ * @return Number of malformed lines skipped.
+ */
+int parseCourseRows(string_view text, const Course::allocator_type& alloc, vector<Course>& courses) {
+    CsvTokenizer tokenizer(text);
+    vector<string_view> courseInfo;
+    int errorCount = 0;
+
+    while (tokenizer.NextRow(courseInfo)) {
+        if (courseInfo.size() < 2) {
+            ++errorCount;
+            continue; // Skip malformed line
+        }
+
+        Course course(alloc);
+        course.courseId = courseInfo[0];
+        course.name = courseInfo[1];
+
+        course.prerequisites.reserve(courseInfo.size() - 2);
+        for (size_t i = 2; i < courseInfo.size(); ++i) {
+            course.prerequisites.emplace_back(courseInfo[i]);
+        }
+
+        courses.push_back(move(course));
+    }
+    return errorCount;
+}
+
+/**
+ * @brief Loads a stream of CSV course data into a tree through a staged pipeline.
+ *
+ * A reader thread cuts the decoded stream into blocks of whole lines, a 
+ * pool of parser threads turns blocks into courses, and the calling thread 
+ * inserts the parsed batches into the tree in stream order. The stages are 
+ * connected by BoundedQueues, and the reader takes a token for each block 
+ * that the builder returns once the block is inserted. Only two blocks per 
+ * parser are in memory at once however long the stream is, even when one 
+ * parser falls behind the others. Duplicates are reported in stream order, 
+ * as loadCourses() reports them for files.
+ *
+ * @param input Any byte stream (a file, stdin, a FIFO), optionally gzip-compressed.
+ * @param courseList The tree to populate.
+ * @param parsers Number of parser threads; 0 uses one per hardware thread.
+ * @param duplicateCount Incremented for each duplicate course skipped.
+ * @return Number of malformed lines skipped.
+ * @throws runtime_error if the stream cannot be read or decoded.
+ */
+int ingestCourseStream(istream& input, BinarySearchTree& courseList, unsigned parsers, int& duplicateCount) {
+    struct TextBlock {
+        size_t sequence = 0;
+        string text;
+    };
+
+    struct ParsedBatch {
+        size_t sequence = 0;
+        unique_ptr<pmr::monotonic_buffer_resource> arena;   /// Declared first so it outlives the courses
+        vector<Course> courses;
+        int errorCount = 0;
+    };
+
+    if (parsers == 0) {
+        parsers = max(1u, thread::hardware_concurrency());
+    }
+
+    // At most window blocks are between the reader and the builder at once
+    size_t window = 2 * static_cast<size_t>(parsers);
+    BoundedQueue<TextBlock> blocks(window);
+    BoundedQueue<ParsedBatch> batches(window);
+    BoundedQueue<size_t> tokens(window);
+    atomic<unsigned> runningParsers(parsers);
+    mutex failureMutex;
+    exception_ptr failure;
+
+    auto fail = [&]() {
+        lock_guard<mutex> lock(failureMutex);
+        if (!failure) {
+            failure = current_exception();
+        }
+        blocks.Close();
+        batches.Close();
+        tokens.Close();
+    };
+
+    for (size_t i = 0; i < window; ++i) {
+        tokens.Push(i);
+    }
+
+    CourseStreamDecoder decoder(input);
+
+    // Reader stage: cut the stream into blocks that end on a line boundary, 
+    // taking a token for each so a stalled parser cannot let the rest run ahead
+    thread reader([&]() {
+        try {
+            string carry;
+            size_t sequence = 0;
+            size_t token;
+
+            while (true) {
+                string text = move(carry);
+                size_t filled = text.size();
+                text.resize(filled + STREAM_BLOCK_BYTES);
+                size_t count = decoder.Read(&text[filled], STREAM_BLOCK_BYTES);
+                text.resize(filled + count);
+
+                if (count == 0) {
+                    if (!text.empty() && tokens.Pop(token)) {
+                        blocks.Push(TextBlock{ sequence++, move(text) });
+                    }
+                    break;
+                }
+
+                // A line longer than a block keeps growing the carry until it ends
+                size_t lastNewline = text.rfind('\n');
+                if (lastNewline == string::npos) {
+                    carry = move(text);
+                    continue;
+                }
+                carry.assign(text, lastNewline + 1, string::npos);
+                text.resize(lastNewline + 1);
+
+                if (!tokens.Pop(token) || !blocks.Push(TextBlock{ sequence++, move(text) })) {
+                    return;
+                }
+            }
+        }
+        catch (...) {
+            fail();
+        }
+        blocks.Close();
+    });
+
+    // Parser stage: each batch gets its own arena, since the tree's is single-threaded
+    vector<thread> parserThreads;
+    for (unsigned i = 0; i < parsers; ++i) {
+        parserThreads.emplace_back([&]() {
+            try {
+                TextBlock block;
+                while (blocks.Pop(block)) {
+                    ParsedBatch batch;
+                    batch.sequence = block.sequence;
+                    batch.arena = make_unique<pmr::monotonic_buffer_resource>(BinarySearchTree::ARENA_SLAB_BYTES);
+                    batch.errorCount = parseCourseRows(block.text, Course::allocator_type(batch.arena.get()), batch.courses);
+
+                    if (!batches.Push(move(batch))) {
+                        break;
+                    }
+                }
+            }
+            catch (...) {
+                fail();
+            }
+            if (runningParsers.fetch_sub(1) == 1) {
+                batches.Close();
+            }
+        });
+    }
+
+    // Builder stage: insert batches in stream order, holding early arrivals back. 
+    // Sequences in flight span less than window, so each has its own slot.
+    int errorCount = 0;
+    try {
+        vector<optional<ParsedBatch>> waiting(window);
+        size_t nextSequence = 0;
+        ParsedBatch batch;
+
+        while (batches.Pop(batch)) {
+            waiting[batch.sequence % window] = move(batch);
+
+            for (optional<ParsedBatch>* ready = &waiting[nextSequence % window]; ready->has_value();
+                 ready = &waiting[nextSequence % window]) {
+                errorCount += (*ready)->errorCount;
+                for (Course& course : (*ready)->courses) {
+                    if (courseList.Contains(course.courseId)) {
+                        BinarySearchTree::DuplicateCourseException ex(course.courseId);
+                        ++duplicateCount;
+                        cout << "Warning: " << ex.what() << endl;
+                    }
+                    else {
+                        courseList.Insert(move(course));
+                    }
+                }
+
+                ready->reset();
+                ++nextSequence;
+                tokens.Push(nextSequence);
+            }
+        }
+    }
+    catch (...) {
+        fail();
+    }
+
+    reader.join();
+    for (thread& worker : parserThreads) {
+        worker.join();
+    }
+
+    if (failure) {
+        rethrow_exception(failure);
+    }
+    return errorCount;
+}
+
+/// Most dependents or cycle members named on one line of the catalog check.
+constexpr size_t VALIDATION_NAMES_PER_LINE = 8;
+
+/**
+ * @brief Prints a list of course IDs in order, eliding all but the first few.
+ *
+ * @param graph The graph the IDs belong to.
+ * @param members The course IDs to print.
+ * @param separator Printed between IDs.
+ */
+void printCourseIds(const PrerequisiteGraph& graph, const vector<uint32_t>& members, const char* separator) {
+    vector<string_view> courseIds;
+    for (uint32_t member : members) {
+        courseIds.push_back(graph.CourseId(member));
+    }
+    sort(courseIds.begin(), courseIds.end());
+
+    for (size_t i = 0; i < courseIds.size() && i < VALIDATION_NAMES_PER_LINE; ++i) {
+        cout << (i == 0 ? "" : separator) << courseIds[i];
+    }
+    if (courseIds.size() > VALIDATION_NAMES_PER_LINE) {
+        cout << " and " << courseIds.size() - VALIDATION_NAMES_PER_LINE << " more";
+    }
+}
+
+/**
+ * @brief Checks a loaded catalog for prerequisites that are not in it and 
+ * for prerequisite cycles, and prints one summary of everything found.
+ *
+ * Works from the catalog's PrerequisiteGraph, which has already resolved 
+ * every prerequisite, and finds cycles with PrerequisiteGraph::Cycles(), so 
+ * the whole check is O(V + E). Callers pass the graph they go on to query, 
+ * so a load builds it only once. Nothing is printed for a clean catalog.
+ *
+ * @param graph The graph of the catalog to check.
+ * @return Number of missing course IDs plus number of cycles.
+ */
+size_t validateCatalog(const PrerequisiteGraph& graph) {
+    vector<pair<string_view, const vector<uint32_t>*>> missing;
+    graph.VisitUnresolved([&missing](string_view courseId, const vector<uint32_t>& dependents) {
+        missing.emplace_back(courseId, &dependents);
+    });
+    sort(missing.begin(), missing.end());
+
+    vector<vector<uint32_t>> cycles = graph.Cycles();
+    if (missing.empty() && cycles.empty()) {
+        return 0;
+    }
+
+    cout << "Catalog check: " << missing.size() << " missing prerequisite course(s) listed "
+         << graph.UnresolvedCount() << " time(s), " << cycles.size() << " prerequisite cycle(s)." << endl;
+
+    for (const auto& [courseId, dependents] : missing) {
+        cout << "  Missing " << courseId << ", listed by ";
+        printCourseIds(graph, *dependents, ", ");
+        cout << endl;
+    }
+    for (const vector<uint32_t>& cycle : cycles) {
+        cout << "  Cycle among ";
+        printCourseIds(graph, cycle, ", ");
+        cout << endl;
+    }
+    return missing.size() + cycles.size();
+}
+
+/**
+ * @brief Loads course data from a CSV file into a binary search tree.
+ *
+ * Validates input, skips malformed lines, and detects duplicates. The rows 
+ * are collected first and handed to BinarySearchTree::BulkLoad().
+ *
+ * Files larger than PARALLEL_LOAD_GRAIN are read and parsed on several 
+ * threads. The file is cut into roughly equal chunks, each boundary is 
+ * moved forward to the next line, and every chunk is read and parsed into 
+ * its own list. The lists are joined in file order, so skipped lines and 
+ * duplicates are counted and reported exactly as a single-threaded load 
+ * would report them.
+ *
+ * Standard input, pipes and compressed files cannot be read in place and 
+ * are loaded through ingestCourseStream() instead.
+ *
+ * Missing prerequisites and prerequisite cycles are not checked here, since 
+ * logged edits may still change them; callers check the final catalog with 
+ * validateCatalog().
+ *
+ * @param filePath Path to the CSV file, or "-" for standard input.
+ * @param courseList The tree to populate.
+ * @param threads Number of threads to use; 0 uses one per hardware thread.
+ * @return Number of invalid lines skipped, or -1 if a fatal error occurred.
+ */
+int loadCourses(string filePath, unique_ptr<BinarySearchTree>& courseList, unsigned threads = 0) {
+    string buffer;
+    vector<unique_ptr<pmr::monotonic_buffer_resource>> chunkArenas;
+    vector<Course> courses;
+    int duplicateCount = 0;
+    int errorCount = 0;
+
+    if (threads == 0) {
+        threads = max(1u, thread::hardware_concurrency());
+    }
+
+    cout << "Loading file " << filePath << endl;
+
+    try {
+        ifstream inCourseFS;
+
+        // Pipes and FIFOs cannot seek, so their size is unknown
+        streamoff fileSize = -1;
+        char magic[2] = {};
+        if (filePath != "-") {
+            inCourseFS.open(filePath, ios::binary);
+
+            if (!inCourseFS.is_open()) {
+                throw runtime_error("Unable to open file: " + filePath);
+            }
+
+            inCourseFS.seekg(0, ios::end);
+            fileSize = inCourseFS.tellg();
+            inCourseFS.clear();
+
+            if (fileSize >= 2) {
+                inCourseFS.seekg(0, ios::beg);
+                inCourseFS.read(magic, sizeof(magic));
+                inCourseFS.seekg(0, ios::beg);
+            }
+        }
+        bool compressed = (magic[0] == '\x1f' && magic[1] == '\x8b') || (magic[0] == '\x28' && magic[1] == '\xb5');
+
+        // Standard input ("-"), pipes and compressed files are streamed through the ingestion pipeline
+        if (fileSize < 0 || compressed) {
+            istream& input = filePath == "-" ? cin : inCourseFS;
+            errorCount = ingestCourseStream(input, *courseList, threads, duplicateCount);
+        }
+        else {
+            inCourseFS.close();
+
+            // The whole file is held in memory; the fields are views into this buffer
+            buffer.resize(static_cast<size_t>(fileSize));
+            size_t chunkCount = min<size_t>(threads, buffer.size() / PARALLEL_LOAD_GRAIN);
+
+            if (chunkCount < 2) {
+                readFileRange(filePath, 0, &buffer[0], buffer.size());
+
+                // Build each course directly with the tree's allocator so its strings are copied only once
+                errorCount = parseCourseRows(buffer, courseList->Allocator(), courses);
+            }
+            else {
+                vector<future<void>> reads;
+                for (size_t i = 0; i < chunkCount; ++i) {
+                    size_t first = buffer.size() * i / chunkCount;
+                    size_t last = buffer.size() * (i + 1) / chunkCount;
+                    reads.push_back(async(launch::async, readFileRange, cref(filePath), first, &buffer[first], last - first));
+                }
+                for (future<void>& read : reads) {
+                    read.get();
+                }
+
+                // Move each boundary past the end of the line it falls in
+                vector<size_t> bounds = { 0 };
+                for (size_t i = 1; i < chunkCount; ++i) {
+                    size_t position = max(buffer.size() * i / chunkCount, bounds.back() + 1) - 1;
+                    const void* newline = memchr(buffer.data() + position, '\n', buffer.size() - position);
+                    bounds.push_back(newline ? static_cast<const char*>(newline) - buffer.data() + 1 : buffer.size());
+                }
+                bounds.push_back(buffer.size());
+
+                // The tree's arena is single-threaded, so each chunk parses into an arena of its own
+                vector<vector<Course>> chunkCourses(chunkCount);
+                vector<future<int>> parses;
+                for (size_t i = 0; i < chunkCount; ++i) {
+                    chunkArenas.push_back(make_unique<pmr::monotonic_buffer_resource>(BinarySearchTree::ARENA_SLAB_BYTES));
+                    string_view chunk(buffer.data() + bounds[i], bounds[i + 1] - bounds[i]);
+                    Course::allocator_type alloc(chunkArenas.back().get());
+                    parses.push_back(async(launch::async, [chunk, alloc, &rows = chunkCourses[i]]() {
+                        return parseCourseRows(chunk, alloc, rows);
+                    }));
+                }
+                for (future<int>& parse : parses) {
+                    errorCount += parse.get();
+                }
+
+                size_t total = 0;
+                for (const vector<Course>& rows : chunkCourses) {
+                    total += rows.size();
+                }
+                courses.reserve(total);
+                for (vector<Course>& rows : chunkCourses) {
+                    move(rows.begin(), rows.end(), back_inserter(courses));
+                }
+            }
+
+            // Load everything that was read, then report duplicates in file order
+            for (size_t row : courseList->BulkLoad(courses, threads)) {
+                BinarySearchTree::DuplicateCourseException ex(courses[row].courseId);
+                ++duplicateCount;
+                cout << "Warning: " << ex.what() << endl;
+            }
+        }
+
+        // Display non-fatal error summary
+        if (errorCount > 0) {
+            cout << "Warning: " << errorCount << " line(s) contained invalid course data and were skipped." << endl;
+        }
+
+        // Display number of duplicate courses ignored
+        if (duplicateCount > 0)
+            cout << "Ignored " << duplicateCount << " duplicate course(s)." << endl;
+
+    } catch (const exception& ex) {
+        cerr << "Fatal error while loading courses: " << ex.what() << endl;
+        return -1;
+    }
+
+    return errorCount;
+}
+
+/**
+ * @brief Replays the edit log that belongs to a CSV file without opening it 
+ * for writing, for runs that only read the catalog.
+ *
+ * Catalogs read from standard input have no log.
+ *
+ * @param filePath Path to the CSV file the tree was loaded from.
+ * @param courseList The loaded tree to apply the logged edits to.
+ * @return Number of edits replayed, or -1 if the log could not be read.
+ */
+int replayCatalogLog(const string& filePath, unique_ptr<BinarySearchTree>& courseList) {
+    if (filePath == "-") {
+        return 0;
+    }
+
+    try {
+        size_t replayed = CatalogLog::ReplayReadOnly(filePath + ".log", *courseList);
+
+        if (replayed > 0) {
+            cout << "Replayed " << replayed << " logged edit(s)." << endl;
+        }
+        return static_cast<int>(replayed);
+
+    } catch (const exception& ex) {
+        cerr << "Fatal error while replaying edit log: " << ex.what() << endl;
+        return -1;
+    }
+}
+
+/**
+ * @brief Opens the edit log that belongs to a CSV file and replays it.
  *
- * @param course The course to display.
+ * The log lives next to the CSV as "<file>.log" and is created if missing. 
+ * Catalogs read from standard input have no log, so edits to them are not 
+ * saved.
+ *
+ * @param filePath Path to the CSV file the tree was loaded from.
+ * @param courseList The loaded tree to apply the logged edits to.
+ * @param log Receives the open log, or nullptr for standard input.
+ * @return Number of edits replayed, or -1 if the log could not be used.
  */
-void displayCourse(Course course) {
-    cout << course.courseId << ", " << course.name << endl;
+int openCatalogLog(const string& filePath, unique_ptr<BinarySearchTree>& courseList, unique_ptr<CatalogLog>& log) {
+    log.reset();
+    if (filePath == "-") {
+        return 0;
+    }
+
+    try {
+        log = make_unique<CatalogLog>(filePath + ".log");
+        size_t replayed = log->Replay(*courseList);
+
+        if (replayed > 0) {
+            cout << "Replayed " << replayed << " logged edit(s)." << endl;
+        }
+        return static_cast<int>(replayed);
+
+    } catch (const exception& ex) {
+        log.reset();
+        cerr << "Fatal error while replaying edit log: " << ex.what() << endl;
+        return -1;
+    }
+}
+
+//============================================================================
+// Benchmark Methods
+//============================================================================
+
+/**
+ * @brief Builds a synthetic catalog for benchmarking.
+ *
+ * Course IDs are unique, spread over several departments, and returned in 
+ * shuffled order so the tree sees a realistic insertion pattern.
+ *
+ * @param rows Number of courses to generate.
+ * @param seed Seed for the shuffle and prerequisite choices.
+ * @return The generated courses.
+ */
+vector<Course> generateSyntheticCatalog(size_t rows, unsigned seed) {
+    static const char* departments[] = { "CSCI", "MATH", "PHYS", "CHEM", "BIOL", "ENGL", "HIST", "ECON" };
+    const size_t departmentCount = sizeof(departments) / sizeof(departments[0]);
+    vector<Course> catalog(rows);
+    mt19937 rng(seed);
+
+    for (size_t i = 0; i < rows; ++i) {
+        string number = to_string(i / departmentCount);
+        number.insert(0, number.size() < 7 ? 7 - number.size() : 0, '0');
+
+        catalog[i].courseId = departments[i % departmentCount] + number;
+        catalog[i].name = "Synthetic Course Number " + to_string(i);
+
+        // Up to two prerequisites chosen from earlier courses
+        for (size_t p = rng() % 3; p > 0 && i > 0; --p) {
+            catalog[i].prerequisites.push_back(catalog[rng() % i].courseId);
+        }
+    }
+    shuffle(catalog.begin(), catalog.end(), rng);
+    return catalog;
+}
+
+/**
+ * @class ScratchDirectory
+ * @brief A new, uniquely named directory under the system temporary 
+ * directory, removed with everything in it when destroyed.
+ *
+ * Benchmarks that need files on disk create them here, so a run never 
+ * overwrites or deletes files in the working directory.
+ */
+class ScratchDirectory {
+
+    private:
+        filesystem::path path;
+
+    public:
+        ScratchDirectory();
+        ~ScratchDirectory();
+
+        ScratchDirectory(const ScratchDirectory&) = delete;
+        ScratchDirectory& operator=(const ScratchDirectory&) = delete;
+
+        string File(const string& name) const;
+};
+
+/**
+ * @brief Creates the directory under a name no other directory has.
+ *
+ * @throws runtime_error if no unused name is found.
+ */
+ScratchDirectory::ScratchDirectory() {
+    filesystem::path base = filesystem::temp_directory_path();
+    random_device entropy;
+
+    for (int attempt = 0; attempt < 100; ++attempt) {
+        path = base / ("abcu_benchmark_" + to_string(entropy()));
+
+        // create_directory() reports false when the name is already taken
+        if (filesystem::create_directory(path)) {
+            return;
+        }
+    }
+    throw runtime_error("Unable to create a scratch directory in " + base.string());
+}
+
+/**
+ * @brief Removes the directory and every file in it.
+ */
+ScratchDirectory::~ScratchDirectory() {
+    error_code ignored;
+    filesystem::remove_all(path, ignored);
+}
+
+/**
+ * @brief Returns the path of a file inside the directory.
+ *
+ * @param name File name.
+ * @return Full path to pass to file APIs.
+ */
+string ScratchDirectory::File(const string& name) const {
+    return (path / name).string();
+}
+
+/**
+ * @brief Writes courses to a CSV file in the format loadCourses() reads.
+ *
+ * @param filePath Path of the file to create or replace.
+ * @param catalog Courses to write, one per line.
+ * @throws runtime_error if the file cannot be written.
+ */
+void writeCatalogCsv(const string& filePath, const vector<Course>& catalog) {
+    ofstream out(filePath, ios::trunc);
+    for (const Course& course : catalog) {
+        out << course.courseId << ',' << course.name;
+        for (const pmr::string& prerequisite : course.prerequisites) {
+            out << ',' << prerequisite;
+        }
+        out << '\n';
+    }
+    if (!out.flush()) {
+        throw runtime_error("Unable to write " + filePath);
+    }
+}
+
+/**
+ * @brief Times loading and then clearing a tree from a synthetic catalog.
+ *
+ * @param label Name printed alongside the timings.
+ * @param tree The tree to load (expected to be empty).
+ * @param catalog The courses to insert.
+ * @param bulk True to load with BulkLoad(), false to Insert() row by row.
+ */
+void benchmarkLoad(const string& label, BinarySearchTree& tree, const vector<Course>& catalog, bool bulk) {
+    using Clock = chrono::steady_clock;
+
+    auto start = Clock::now();
+    if (bulk) {
+        vector<Course> rows(catalog);
+        tree.BulkLoad(rows);
+    }
+    else {
+        for (const Course& course : catalog) {
+            tree.Insert(course);
+        }
+    }
+    auto loaded = Clock::now();
+    tree.Clear();
+    auto cleared = Clock::now();
+
+    double loadMs = chrono::duration<double, milli>(loaded - start).count();
+    double clearMs = chrono::duration<double, milli>(cleared - loaded).count();
+
+    cout << "  " << label << ": load " << loadMs << " ms ("
+         << static_cast<size_t>(catalog.size() / (loadMs / 1000.0)) << " courses/s), clear "
+         << clearMs << " ms" << endl;
+}
+
+/**
+ * @brief Times a batch of lookups against a tree.
+ *
+ * @param label Name printed alongside the timing.
+ * @param tree The tree to query.
+ * @param queries Course IDs to look up.
+ * @param copyResults True to look up with Search(), false to use Find().
+ */
+void benchmarkLookups(const string& label, const BinarySearchTree& tree, const vector<string>& queries,
+                      bool copyResults) {
+    using Clock = chrono::steady_clock;
+    size_t found = 0;
+
+    auto start = Clock::now();
+    for (const string& courseId : queries) {
+        if (copyResults) {
+            found += !tree.Search(courseId).courseId.empty();
+        }
+        else {
+            found += tree.Find(courseId) != nullptr;
+        }
+    }
+    double lookupMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    cout << "  " << label << ": " << lookupMs << " ms ("
+         << static_cast<size_t>(queries.size() / (lookupMs / 1000.0)) << " lookups/s, "
+         << found << " found)" << endl;
+}
+
+/**
+ * @brief Compares the AVL and B-tree backends on one workload.
+ *
+ * The workloads are "insert" (load every course), "lookup" (load, then one 
+ * lookup per course) and "mixed" (load half, then random inserts, removes 
+ * and lookups over the whole catalog).
+ *
+ * @param workload Name of the workload to run.
+ * @param catalog The courses to use.
+ */
+void benchmarkBackends(const string& workload, const vector<Course>& catalog) {
+    using Clock = chrono::steady_clock;
+
+    for (TreeBackend backend : { TreeBackend::AVL, TreeBackend::BTree }) {
+        BinarySearchTree tree(backend);
+        mt19937 rng(262);
+        size_t found = 0;
+        size_t preload = workload == "insert" ? 0 : (workload == "lookup" ? catalog.size() : catalog.size() / 2);
+
+        for (size_t i = 0; i < preload; ++i) {
+            tree.Insert(catalog[i]);
+        }
+
+        auto start = Clock::now();
+        if (workload == "insert") {
+            for (const Course& course : catalog) {
+                tree.Insert(course);
+            }
+        }
+        else {
+            for (size_t i = 0; i < catalog.size(); ++i) {
+                const Course& course = catalog[rng() % catalog.size()];
+                unsigned operation = workload == "lookup" ? 0 : rng() % 4;
+
+                if (operation == 1 && !tree.Contains(course.courseId)) {
+                    tree.Insert(course);
+                }
+                else if (operation == 2) {
+                    tree.Remove(string(course.courseId));
+                }
+                else {
+                    found += tree.Contains(course.courseId);
+                }
+            }
+        }
+        double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+        cout << "  " << workload << ", " << (backend == TreeBackend::AVL ? "AVL" : "B-tree")
+             << ": " << elapsedMs << " ms (" << found << " lookups found)" << endl;
+    }
+}
+
+/**
+ * @brief Stress-tests lock-free reads of a SharedCatalog.
+ *
+ * Reader threads look up random course IDs until told to stop. With 
+ * reloads, the calling thread meanwhile rebuilds the catalog and publishes 
+ * it that many times; without, the readers run for one second. Every ID is 
+ * in every published tree, so a missed lookup means a reader saw a torn or 
+ * freed tree.
+ *
+ * @param catalog The courses to publish.
+ * @param reloads Number of catalog swaps to make while the readers run.
+ */
+void benchmarkSharedCatalog(const vector<Course>& catalog, size_t reloads) {
+    using Clock = chrono::steady_clock;
+
+    auto build = [&catalog]() {
+        unique_ptr<BinarySearchTree> tree = make_unique<BinarySearchTree>();
+        vector<Course> rows(catalog);
+        tree->BulkLoad(rows);
+        return tree;
+    };
+
+    SharedCatalog shared;
+    shared.Publish(build());
+
+    unsigned readerCount = min<unsigned>(max(2u, thread::hardware_concurrency()), SharedCatalog::MAX_READERS);
+    atomic<bool> stop(false);
+    atomic<size_t> lookups(0);
+    atomic<size_t> missed(0);
+    vector<thread> readers;
+
+    auto start = Clock::now();
+    for (unsigned r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            SharedCatalog::Reader reader(shared);
+            mt19937 rng(700 + r);
+            size_t done = 0;
+            size_t notFound = 0;
+
+            while (!stop.load(memory_order_relaxed)) {
+                const Course& query = catalog[rng() % catalog.size()];
+                bool found = reader.Read([&query](const BinarySearchTree& tree) {
+                    return tree.Find(query.courseId) != nullptr;
+                });
+                notFound += found ? 0 : 1;
+                ++done;
+            }
+            lookups += done;
+            missed += notFound;
+        });
+    }
+
+    if (reloads == 0) {
+        this_thread::sleep_for(chrono::seconds(1));
+    }
+    for (size_t i = 0; i < reloads; ++i) {
+        shared.Publish(build());
+    }
+    stop = true;
+    for (thread& reader : readers) {
+        reader.join();
+    }
+    double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    cout << "  " << readerCount << " readers, " << reloads << " reloads: "
+         << static_cast<size_t>(lookups / (elapsedMs / 1000.0)) << " lookups/s, "
+         << missed << " missed, " << shared.RetiredCount() << " retired trees pending" << endl;
+}
+
+/**
+ * @brief Times concurrent inserts and lookups on a ShardedCatalog.
+ *
+ * The catalog is split into one contiguous slice per thread; each thread 
+ * inserts its slice and then looks every course in it back up.
+ *
+ * @param catalog The courses to insert.
+ * @param threadCount Number of worker threads.
+ */
+void benchmarkShardedCatalog(const vector<Course>& catalog, unsigned threadCount) {
+    using Clock = chrono::steady_clock;
+
+    ShardedCatalog sharded;
+    atomic<size_t> found(0);
+    vector<thread> workers;
+
+    auto runWorkers = [&](auto work) {
+        workers.clear();
+        for (unsigned t = 0; t < threadCount; ++t) {
+            size_t first = catalog.size() * t / threadCount;
+            size_t last = catalog.size() * (t + 1) / threadCount;
+            workers.emplace_back([&work, first, last]() {
+                work(first, last);
+            });
+        }
+        for (thread& worker : workers) {
+            worker.join();
+        }
+    };
+
+    auto start = Clock::now();
+    runWorkers([&](size_t first, size_t last) {
+        for (size_t i = first; i < last; ++i) {
+            sharded.Insert(catalog[i]);
+        }
+    });
+    auto inserted = Clock::now();
+    runWorkers([&](size_t first, size_t last) {
+        size_t hits = 0;
+        for (size_t i = first; i < last; ++i) {
+            hits += sharded.Contains(catalog[i].courseId) ? 1 : 0;
+        }
+        found += hits;
+    });
+    auto finished = Clock::now();
+
+    double insertMs = chrono::duration<double, milli>(inserted - start).count();
+    double lookupMs = chrono::duration<double, milli>(finished - inserted).count();
+
+    cout << "  " << threadCount << " thread(s), " << sharded.ShardCount() << " shards: insert "
+         << static_cast<size_t>(catalog.size() / (insertMs / 1000.0)) << " courses/s, lookup "
+         << static_cast<size_t>(catalog.size() / (lookupMs / 1000.0)) << " lookups/s ("
+         << found << " found)" << endl;
+}
+
+/**
+ * @brief Times BulkLoad() with increasing thread counts.
+ *
+ * Doubles the thread count up to the number of hardware threads. Copying 
+ * the catalog for each run is not included in the time.
+ *
+ * @param catalog The courses to load.
+ */
+void benchmarkParallelBuild(const vector<Course>& catalog) {
+    using Clock = chrono::steady_clock;
+
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    double serialMs = 0;
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        BinarySearchTree tree;
+        vector<Course> rows(catalog);
+
+        auto start = Clock::now();
+        tree.BulkLoad(rows, threads);
+        double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+        if (threads == 1) {
+            serialMs = elapsedMs;
+        }
+        cout << "  " << threads << " thread(s): " << elapsedMs << " ms ("
+             << serialMs / elapsedMs << "x, " << tree.Size() << " courses)" << endl;
+    }
+}
+
+/**
+ * @brief Times edits and snapshots on a PersistentCatalog and reports sharing.
+ *
+ * Keeps a snapshot per version while applying a batch of removes and 
+ * inserts between versions, then searches the oldest version and counts 
+ * how many distinct nodes all the versions hold together.
+ *
+ * @param catalog The courses for the first version.
+ * @param versions Number of versions to keep.
+ * @param editsPerVersion Number of edits between consecutive versions.
+ */
+void benchmarkPersistentCatalog(const vector<Course>& catalog, size_t versions, size_t editsPerVersion) {
+    using Clock = chrono::steady_clock;
+
+    BinarySearchTree tree;
+    vector<Course> rows(catalog);
+    tree.BulkLoad(rows);
+
+    PersistentCatalog current(tree);
+    vector<PersistentCatalog> history;
+    mt19937 rng(1300);
+    double editMs = 0;
+    double snapshotMs = 0;
+
+    for (size_t v = 0; v < versions; ++v) {
+        auto start = Clock::now();
+        history.push_back(current.Snapshot());
+        auto snapped = Clock::now();
+
+        for (size_t e = 0; e < editsPerVersion; ++e) {
+            current.Remove(catalog[rng() % catalog.size()].courseId);
+
+            Course added;
+            added.courseId = "EDIT" + to_string(v) + "-" + to_string(e);
+            added.name = "Edited Course";
+            current.Insert(move(added));
+        }
+        auto edited = Clock::now();
+
+        snapshotMs += chrono::duration<double, milli>(snapped - start).count();
+        editMs += chrono::duration<double, milli>(edited - snapped).count();
+    }
+    history.push_back(current.Snapshot());
+
+    // Every ID of the original catalog is still in the first version
+    auto start = Clock::now();
+    size_t found = 0;
+    for (const Course& course : catalog) {
+        found += history.front().Find(course.courseId) ? 1 : 0;
+    }
+    double lookupMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    size_t edits = versions * editsPerVersion * 2;
+    size_t distinct = PersistentCatalog::CountDistinctNodes(history);
+
+    cout << "  " << history.size() << " versions, " << edits << " edits: "
+         << static_cast<size_t>(edits / (editMs / 1000.0)) << " edits/s, "
+         << snapshotMs / versions * 1000.0 << " us per snapshot" << endl;
+    cout << "  oldest version lookups: " << static_cast<size_t>(catalog.size() / (lookupMs / 1000.0))
+         << " lookups/s (" << found << " found)" << endl;
+    cout << "  distinct nodes: " << distinct << " (full copies would need "
+         << history.size() * catalog.size() << ")" << endl;
+}
+
+/**
+ * @brief Times the join-based set operations against re-inserting.
+ *
+ * Builds two overlapping catalogs from the first and last 60% of the 
+ * synthetic courses, renaming some of the shared courses in the second, 
+ * then times each set operation and, as a baseline, a union done by 
+ * inserting both catalogs into a fresh tree.
+ *
+ * @param catalog The courses to split into two catalogs.
+ */
+void benchmarkSetOperations(const vector<Course>& catalog) {
+    using Clock = chrono::steady_clock;
+
+    BinarySearchTree first;
+    BinarySearchTree second;
+    vector<Course> firstRows(catalog.begin(), catalog.begin() + catalog.size() * 6 / 10);
+    vector<Course> secondRows(catalog.begin() + catalog.size() * 4 / 10, catalog.end());
+    for (size_t i = 0; i < secondRows.size(); i += 10) {
+        secondRows[i].name += " (Revised)";
+    }
+    first.BulkLoad(firstRows);
+    second.BulkLoad(secondRows);
+
+    auto time = [](const string& label, auto operation) {
+        auto start = Clock::now();
+        size_t courses = operation();
+        double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << "  " << label << ": " << elapsedMs << " ms (" << courses << " courses)" << endl;
+    };
+
+    time("Union", [&]() { return BinarySearchTree::Union(first, second)->Size(); });
+    time("Intersection", [&]() { return BinarySearchTree::Intersection(first, second)->Size(); });
+    time("Difference", [&]() { return BinarySearchTree::Difference(first, second)->Size(); });
+    time("Diff (changed courses)", [&]() { return BinarySearchTree::Diff(first, second)->Size(); });
+    time("Union by re-inserting", [&]() {
+        BinarySearchTree merged;
+        for (const BinarySearchTree* tree : { &first, &second }) {
+            tree->VisitInOrder([&merged](const Course& course) {
+                if (!merged.Contains(course.courseId)) {
+                    merged.Insert(course);
+                }
+            });
+        }
+        return merged.Size();
+    });
+}
+
+/**
+ * @brief Times loading a CSV file with different numbers of threads.
+ *
+ * Writes the catalog to a CSV file in a ScratchDirectory. Files smaller than two PARALLEL_LOAD_GRAIN chunks 
+ * are always loaded on one thread.
+ *
+ * @param catalog Courses to write.
+ */
+void benchmarkParallelLoad(const vector<Course>& catalog) {
+    using Clock = chrono::steady_clock;
+    ScratchDirectory scratch;
+    const string csvPath = scratch.File("catalog.csv");
+    writeCatalogCsv(csvPath, catalog);
+
+    unsigned maxThreads = max(1u, thread::hardware_concurrency());
+    double serialMs = 0;
+
+    for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+        unique_ptr<BinarySearchTree> tree = make_unique<BinarySearchTree>();
+
+        auto start = Clock::now();
+        loadCourses(csvPath, tree, threads);
+        double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+        if (threads == 1) {
+            serialMs = elapsedMs;
+        }
+        cout << "  " << threads << " thread(s): " << elapsedMs << " ms ("
+             << serialMs / elapsedMs << "x, " << tree->Size() << " courses)" << endl;
+    }
+}
+
+/**
+ * @brief Compares the CSV tokenizer with splitting lines through stringstreams.
+ *
+ * Both runs tokenize the same in-memory CSV text, so only the parsing is 
+ * timed.
+ *
+ * @param catalog Courses to format as CSV.
+ */
+void benchmarkTokenizer(const vector<Course>& catalog) {
+    using Clock = chrono::steady_clock;
+
+    string text;
+    for (const Course& course : catalog) {
+        text.append(course.courseId).append(",").append(course.name);
+        for (const pmr::string& prerequisite : course.prerequisites) {
+            text.append(",").append(prerequisite);
+        }
+        text.append("\n");
+    }
+
+    auto report = [&text](const string& label, Clock::time_point start, size_t fields) {
+        double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << "  " << label << ": " << elapsedMs << " ms ("
+             << text.size() / (elapsedMs / 1000.0) / (1 << 20) << " MB/s, " << fields << " fields)" << endl;
+    };
+
+    auto start = Clock::now();
+    size_t fields = 0;
+    {
+        stringstream input(text);
+        string line;
+        string field;
+        while (getline(input, line)) {
+            stringstream ssLine(line);
+            vector<string> tokens;
+            while (getline(ssLine, field, ',')) {
+                tokens.push_back(field);
+            }
+            fields += tokens.size();
+        }
+    }
+    report("getline and stringstream", start, fields);
+
+    start = Clock::now();
+    fields = 0;
+    {
+        CsvTokenizer tokenizer(text);
+        vector<string_view> tokens;
+        while (tokenizer.NextRow(tokens)) {
+            fields += tokens.size();
+        }
+    }
+#if defined(ABCU_USE_AVX2)
+    report("CsvTokenizer (AVX2)", start, fields);
+#elif defined(ABCU_USE_SSE2)
+    report("CsvTokenizer (SSE2)", start, fields);
+#else
+    report("CsvTokenizer (scalar)", start, fields);
+#endif
+}
+
+/**
+ * @brief Compares starting from the CSV file with opening a binary catalog.
+ *
+ * Writes the catalog to CSV and binary files in a ScratchDirectory, times 
+ * loading the CSV into a tree against mapping the binary file, then times 
+ * the same lookups against both.
+ *
+ * @param catalog Courses to write.
+ */
+void benchmarkMappedCatalog(const vector<Course>& catalog) {
+    using Clock = chrono::steady_clock;
+    ScratchDirectory scratch;
+    const string csvPath = scratch.File("catalog.csv");
+    const string binaryPath = scratch.File("catalog.bin");
+
+    writeCatalogCsv(csvPath, catalog);
+    {
+        BinarySearchTree tree;
+        vector<Course> rows(catalog);
+        tree.BulkLoad(rows);
+        MappedCatalog::Write(binaryPath, tree);
+    }
+
+    vector<string> queries;
+    mt19937 rng(17);
+    for (size_t i = 0; i < catalog.size(); ++i) {
+        queries.emplace_back(catalog[rng() % catalog.size()].courseId);
+    }
+
+    auto start = Clock::now();
+    unique_ptr<BinarySearchTree> tree = make_unique<BinarySearchTree>();
+    loadCourses(csvPath, tree);
+    double csvMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    start = Clock::now();
+    MappedCatalog mapped(binaryPath);
+    double mapMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    cout << "  Load CSV into tree: " << csvMs << " ms (" << tree->Size() << " courses)" << endl;
+    cout << "  Open binary catalog: " << mapMs << " ms (" << mapped.Size() << " courses)" << endl;
+
+    benchmarkLookups("Tree Find", *tree, queries, false);
+
+    size_t found = 0;
+    start = Clock::now();
+    for (const string& courseId : queries) {
+        found += mapped.Find(courseId).has_value();
+    }
+    double lookupMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+    cout << "  Mapped Find: " << lookupMs << " ms ("
+         << static_cast<size_t>(queries.size() / (lookupMs / 1000.0)) << " lookups/s, "
+         << found << " found)" << endl;
+}
+
+/**
+ * @brief Times durable edits through the write-ahead log.
+ *
+ * Compares committing every edit on its own with several threads sharing 
+ * group commits, and with rewriting the whole CSV after each edit. The 
+ * files are written in a ScratchDirectory.
+ *
+ * @param catalog Courses to edit.
+ * @param edits Number of edits per run.
+ * @param threadCount Number of committing threads in the group commit run.
+ */
+void benchmarkCatalogLog(const vector<Course>& catalog, size_t edits, unsigned threadCount) {
+    using Clock = chrono::steady_clock;
+    ScratchDirectory scratch;
+    const string logPath = scratch.File("catalog.csv.log");
+    edits = min(edits, catalog.size());
+
+    auto report = [edits](const string& label, Clock::time_point start) {
+        double elapsedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+        cout << "  " << label << ": " << elapsedMs << " ms ("
+             << static_cast<size_t>(edits / (elapsedMs / 1000.0)) << " durable edits/s)" << endl;
+    };
+
+    {
+        CatalogLog log(logPath);
+        auto start = Clock::now();
+        for (size_t i = 0; i < edits; ++i) {
+            log.Commit(log.AppendInsert(catalog[i]));
+        }
+        report("Commit per edit, 1 thread", start);
+    }
+
+    remove(logPath.c_str());
+    {
+        CatalogLog log(logPath);
+        vector<thread> threads;
+        auto start = Clock::now();
+        for (unsigned t = 0; t < threadCount; ++t) {
+            threads.emplace_back([&log, &catalog, edits, t, threadCount]() {
+                for (size_t i = t; i < edits; i += threadCount) {
+                    log.Commit(log.AppendInsert(catalog[i]));
+                }
+            });
+        }
+        for (thread& worker : threads) {
+            worker.join();
+        }
+        report("Group commit, " + to_string(threadCount) + " threads", start);
+    }
+
+    // Rewriting the snapshot costs O(n) per edit, so time a few and scale
+    {
+        BinarySearchTree tree;
+        vector<Course> rows(catalog);
+        tree.BulkLoad(rows);
+
+        const string csvPath = scratch.File("catalog.csv");
+        const size_t rewrites = 3;
+        CatalogLog log(logPath);
+        auto start = Clock::now();
+        for (size_t i = 0; i < rewrites; ++i) {
+            log.Compact(tree, csvPath);
+        }
+        double perEditMs = chrono::duration<double, milli>(Clock::now() - start).count() / rewrites;
+        cout << "  Rewrite CSV per edit: " << perEditMs * edits << " ms (estimated, "
+             << static_cast<size_t>(1000.0 / perEditMs) << " durable edits/s)" << endl;
+    }
+}
+
+/**
+ * @brief Compares walking prerequisites through the tree with walking the graph.
+ *
+ * Both walks collect every direct and indirect prerequisite of a sample of 
+ * courses; the tree walk looks up each prerequisite by its string ID, the 
+ * graph walk follows integer edges. Also times a rebuild against the same 
+ * number of incremental edits.
+ *
+ * @param catalog Courses to load.
+ * @param samples Number of courses whose prerequisites are collected.
+ */
+void benchmarkPrerequisiteGraph(const vector<Course>& catalog, size_t samples) {
+    using Clock = chrono::steady_clock;
+
+    BinarySearchTree tree;
+    vector<Course> rows(catalog);
+    tree.BulkLoad(rows);
 
-    //If there are no prerequisites
-    if (course.prerequisites.empty()) {
-        cout << "Prerequisites: None";
+    auto start = Clock::now();
+    PrerequisiteGraph graph(tree);
+    double buildMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Build: " << buildMs << " ms (" << graph.Size() << " courses, "
+         << graph.EdgeCount() << " edges)" << endl;
+
+    samples = min(samples, catalog.size());
+    size_t reached = 0;
+
+    start = Clock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        unordered_set<string> seen;
+        vector<const Course*> pending = { tree.Find(catalog[i].courseId) };
+        while (!pending.empty()) {
+            const Course* course = pending.back();
+            pending.pop_back();
+            for (const pmr::string& prerequisite : course->prerequisites) {
+                const Course* found = tree.Find(prerequisite);
+                if (found && seen.insert(string(prerequisite)).second) {
+                    pending.push_back(found);
+                }
+            }
+        }
+        reached += seen.size();
     }
-    //Else
-    else {
-        cout << "Prerequisites: ";
-        //For Each Prerequisite
-        for (int i = 0; i < course.prerequisites.size(); i++) {
-            //Display Prerequisite
-            cout << course.prerequisites.at(i);
-            //If more than one prerequisite in the vector and not the last element
-            if (course.prerequisites.size() > 1 && course.prerequisites.size() - 1 != i) {
-                cout << ", ";
+    double treeMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Transitive prerequisites by tree lookups: " << treeMs << " ms (" << reached << " reached)" << endl;
+
+    reached = 0;
+    vector<uint32_t> visitedBy(graph.IdBound(), PrerequisiteGraph::NO_COURSE);
+    vector<uint32_t> pending;
+    start = Clock::now();
+    for (size_t i = 0; i < samples; ++i) {
+        uint32_t source = graph.IdOf(catalog[i].courseId);
+        pending.assign(1, source);
+        while (!pending.empty()) {
+            uint32_t course = pending.back();
+            pending.pop_back();
+            for (uint32_t prerequisite : graph.Prerequisites(course)) {
+                if (visitedBy[prerequisite] != i) {
+                    visitedBy[prerequisite] = static_cast<uint32_t>(i);
+                    pending.push_back(prerequisite);
+                    ++reached;
+                }
             }
         }
     }
-    cout << endl;
+    double graphMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Transitive prerequisites by graph edges: " << graphMs << " ms (" << reached << " reached)" << endl;
+
+    // Remove and re-insert a sample of courses, keeping the graph in step
+    size_t edits = min<size_t>(samples, 10000);
+    start = Clock::now();
+    for (size_t i = 0; i < edits; ++i) {
+        Course course = *tree.Find(catalog[i].courseId);
+        graph.Remove(course);
+        tree.Remove(course.courseId);
+        tree.Insert(course);
+        graph.Insert(course);
+    }
+    double editMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  " << edits << " incremental remove/insert pairs: " << editMs << " ms" << endl;
 }
 
+/**
+ * @brief Times computing every course's transitive prerequisites at once 
+ * against searching the graph course by course, and finding the courses 
+ * downstream of a course by rescanning the catalog against following 
+ * dependent edges.
+ *
+ * Uses its own catalog, since the closure matrix grows with the square of 
+ * the course count.
+ *
+ * @param courses Number of synthetic courses to generate.
+ * @param threadCount Threads for the all-at-once computation.
+ */
+void benchmarkPrerequisiteClosure(size_t courses, unsigned threadCount) {
+    using Clock = chrono::steady_clock;
+
+    vector<Course> catalog = generateSyntheticCatalog(courses, 502);
+    BinarySearchTree tree;
+    vector<Course> rows(catalog);
+    tree.BulkLoad(rows);
+    PrerequisiteGraph graph(tree);
+
+    size_t reached = 0;
+    PrerequisiteClosure searched(graph);
+    auto start = Clock::now();
+    for (uint32_t id = 0; id < graph.IdBound(); ++id) {
+        reached += searched.Of(id).size();
+    }
+    double searchMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Per-course search, " << graph.Size() << " courses: " << searchMs
+         << " ms (" << reached << " reached)" << endl;
+
+    for (unsigned threads : { 1u, threadCount }) {
+        PrerequisiteClosure closure(graph);
+        start = Clock::now();
+        closure.ComputeAll(threads);
+        double computeMs = chrono::duration<double, milli>(Clock::now() - start).count();
+
+        reached = 0;
+        for (uint32_t id = 0; id < graph.IdBound(); ++id) {
+            reached += closure.Of(id).size();
+        }
+        cout << "  Bitset propagation, " << threads << " thread(s): " << computeMs
+             << " ms (" << reached << " reached, " << closure.SplitLevels() << " level(s) split across threads)" << endl;
+    }
+
+    reached = 0;
+    start = Clock::now();
+    for (uint32_t id = 0; id < graph.IdBound(); ++id) {
+        reached += searched.Of(id).size();
+    }
+    double cachedMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Cached queries: " << cachedMs << " ms" << endl;
+
+    // Downstream impact of a few courses, by rescanning the catalog until nothing new turns up
+    size_t impactSamples = min<size_t>(catalog.size(), 20);
+    reached = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < impactSamples; ++i) {
+        unordered_set<string_view> affected = { catalog[i].courseId };
+        for (size_t before = 0; before != affected.size(); ) {
+            before = affected.size();
+            tree.VisitInOrder([&affected](const Course& course) {
+                for (const pmr::string& prerequisite : course.prerequisites) {
+                    if (affected.count(prerequisite)) {
+                        affected.insert(course.courseId);
+                        break;
+                    }
+                }
+            });
+        }
+        reached += affected.size() - 1;
+    }
+    double scanMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Impact of " << impactSamples << " courses by catalog scans: " << scanMs
+         << " ms (" << reached << " affected)" << endl;
 
+    reached = 0;
+    start = Clock::now();
+    for (size_t i = 0; i < impactSamples; ++i) {
+        reached += searched.Impact(graph.IdOf(catalog[i].courseId)).size();
+    }
+    double impactMs = chrono::duration<double, milli>(Clock::now() - start).count();
+    cout << "  Impact of " << impactSamples << " courses by dependent edges: " << impactMs
+         << " ms (" << reached << " affected)" << endl;
+}
 
 /**
- * @brief Splits a CSV line into tokens based on a delimiter.
+ * @brief Runs the course planner benchmarks on a synthetic catalog.
  *
- * @param line The line to split.
- * @param delimiter The delimiter character (e.g., ',').
- * @return A vector of split elements.
+ * @param rows Number of synthetic courses to generate.
+ * @return Exit status code.
  */
-vector<string> splitLine(const string& line, char delimiter) {
-    vector<string> splitLine;
-    stringstream ssLine(line);
-    string lineElement;
+int runBenchmarks(size_t rows) {
+    cout << "Generating " << rows << " synthetic courses..." << endl;
+    vector<Course> catalog = generateSyntheticCatalog(rows, 499);
+
+    cout << "Load benchmark:" << endl;
+    {
+        BinarySearchTree heapTree(pmr::new_delete_resource());
+        benchmarkLoad("heap-allocated nodes", heapTree, catalog, false);
+    }
+    {
+        BinarySearchTree arenaTree;
+        benchmarkLoad("arena-allocated nodes", arenaTree, catalog, false);
+        benchmarkLoad("arena-allocated nodes, bulk load", arenaTree, catalog, true);
+    }
+
+    cout << "Parallel build benchmark:" << endl;
+    benchmarkParallelBuild(catalog);
+
+    cout << "Lookup benchmark:" << endl;
+    {
+        BinarySearchTree tree;
+        vector<string> queries;
+        mt19937 rng(400);
+
+        for (const Course& course : catalog) {
+            tree.Insert(course);
+        }
+        for (size_t i = 0; i < rows; ++i) {
+            queries.emplace_back(catalog[rng() % rows].courseId);
+        }
+
+        benchmarkLookups("Search (copies each course)", tree, queries, true);
+        benchmarkLookups("Find (zero-copy)", tree, queries, false);
+    }
 
-    while (getline(ssLine, lineElement, delimiter)) {
-        splitLine.push_back(lineElement);
+    cout << "Backend benchmark:" << endl;
+    for (const char* workload : { "insert", "lookup", "mixed" }) {
+        benchmarkBackends(workload, catalog);
     }
-    return splitLine;
+
+    cout << "Shared catalog benchmark:" << endl;
+    benchmarkSharedCatalog(catalog, 0);
+    benchmarkSharedCatalog(catalog, 3);
+
+    cout << "Sharded catalog benchmark:" << endl;
+    benchmarkShardedCatalog(catalog, 1);
+    benchmarkShardedCatalog(catalog, max(4u, thread::hardware_concurrency()));
+
+    cout << "Persistent catalog benchmark:" << endl;
+    benchmarkPersistentCatalog(catalog, 8, 1000);
+
+    cout << "Set operation benchmark:" << endl;
+    benchmarkSetOperations(catalog);
+
+    cout << "CSV tokenizer benchmark:" << endl;
+    benchmarkTokenizer(catalog);
+
+    cout << "Parallel load benchmark:" << endl;
+    benchmarkParallelLoad(catalog);
+
+    cout << "Binary catalog benchmark:" << endl;
+    benchmarkMappedCatalog(catalog);
+
+    cout << "Prerequisite graph benchmark:" << endl;
+    benchmarkPrerequisiteGraph(catalog, 100000);
+
+    cout << "Prerequisite closure benchmark:" << endl;
+    benchmarkPrerequisiteClosure(min<size_t>(rows, 20000), max(4u, thread::hardware_concurrency()));
+
+    cout << "Write-ahead log benchmark:" << endl;
+    benchmarkCatalogLog(catalog, 2000, max(4u, thread::hardware_concurrency()));
+
+    return 0;
 }
 
+//============================================================================
+// Self Checks
+//============================================================================
+
 /**
- * @brief Loads course data from a CSV file into a binary search tree.
+ * @brief Stress-tests SharedCatalog by republishing it under running readers.
  *
- * Validates input, skips malformed lines, and detects duplicates.
+ * Version v of the catalog holds CHECK_BASE_COURSES + v % 5 + 1 courses, 
+ * all named v, so a read can tell which version it got from any one 
+ * course. Each read checks that the tree it was handed is one whole 
+ * version (right size, every sampled course from the same version) and 
+ * no older than the version its previous read saw. Once the readers stop, 
+ * every retired tree must be reclaimable, and a reader beyond MAX_READERS 
+ * must be refused.
  *
- * @param filePath Path to the CSV file.
- * @param courseList The tree to populate.
- * @return Number of invalid lines skipped, or -1 if a fatal error occurred.
+ * Built with -fsanitize=thread or -fsanitize=address, this also catches 
+ * races on the published pointer and reads of trees freed too early.
+ *
+ * @param versions Number of versions to publish while the readers run.
+ * @return Number of failed checks.
  */
-int loadCourses(string filePath, unique_ptr<BinarySearchTree>& courseList) {
-    string line;
-    vector<string> courseInfo;
-    int duplicateCount = 0;
-    int errorCount = 0;
+size_t checkSharedCatalog(size_t versions) {
+    constexpr size_t CHECK_BASE_COURSES = 2000;
 
-    cout << "Loading file " << filePath << endl;
+    auto build = [](size_t version) {
+        vector<Course> rows(CHECK_BASE_COURSES + version % 5 + 1);
+        for (size_t i = 0; i < rows.size(); ++i) {
+            rows[i].courseId = "CHK" + to_string(i);
+            rows[i].name = to_string(version);
+        }
+        unique_ptr<BinarySearchTree> tree = make_unique<BinarySearchTree>();
+        tree->BulkLoad(rows);
+        return tree;
+    };
 
-    try {
-        ifstream inCourseFS(filePath);
+    SharedCatalog shared;
+    shared.Publish(build(0));
 
-        if (!inCourseFS.is_open()) {
-            throw runtime_error("Unable to open file: " + filePath);
-        }
+    unsigned readerCount = min<unsigned>(max(4u, thread::hardware_concurrency()), SharedCatalog::MAX_READERS);
+    atomic<bool> stop(false);
+    atomic<size_t> reads(0);
+    atomic<size_t> torn(0);
+    atomic<size_t> stale(0);
+    vector<thread> readers;
 
-        while (getline(inCourseFS, line)) {
-            courseInfo = splitLine(line, ',');
+    for (unsigned r = 0; r < readerCount; ++r) {
+        readers.emplace_back([&, r]() {
+            SharedCatalog::Reader reader(shared);
+            mt19937 rng(900 + r);
+            size_t lastVersion = 0;
+            size_t done = 0;
 
-            if (courseInfo.size() < 2) {
-                ++errorCount;
-                continue; // Skip malformed line
-            }
+            while (!stop.load(memory_order_relaxed) || done == 0) {
+                size_t version = 0;
+                bool whole = reader.Read([&](const BinarySearchTree& tree) {
+                    const Course* marker = tree.Find("CHK0");
+                    if (!marker) {
+                        return false;
+                    }
+                    version = stoul(string(marker->name));
 
-            Course course;
-            course.courseId = courseInfo[0];
-            course.name = courseInfo[1];
+                    const Course* sample = tree.Find("CHK" + to_string(rng() % CHECK_BASE_COURSES));
+                    return tree.Size() == CHECK_BASE_COURSES + version % 5 + 1 &&
+                           sample && sample->name == marker->name;
+                });
 
-            for (size_t i = 2; i < courseInfo.size(); ++i) {
-                course.prerequisites.push_back(courseInfo[i]);
+                torn += whole ? 0 : 1;
+                stale += version < lastVersion ? 1 : 0;
+                lastVersion = max(lastVersion, version);
+                ++done;
             }
+            reads += done;
+        });
+    }
 
-            try {
-                courseList->Insert(course);
-            } catch (const BinarySearchTree::DuplicateCourseException& ex) {
-                ++duplicateCount;
-                cout << "Warning: " << ex.what() << endl;
-            }
+    for (size_t version = 1; version <= versions; ++version) {
+        shared.Publish(build(version));
+    }
+    stop = true;
+    for (thread& reader : readers) {
+        reader.join();
+    }
+
+    size_t failures = (torn > 0) + (stale > 0);
+    cout << "  " << readerCount << " readers, " << versions << " versions: " << reads << " reads, "
+         << torn << " torn, " << stale << " went back to an older version" << endl;
+
+    shared.Reclaim();
+    if (shared.RetiredCount() != 0) {
+        cout << "  FAILED: " << shared.RetiredCount() << " retired tree(s) left with no readers active" << endl;
+        ++failures;
+    }
+
+    vector<unique_ptr<SharedCatalog::Reader>> slots;
+    for (int i = 0; i < SharedCatalog::MAX_READERS; ++i) {
+        slots.push_back(make_unique<SharedCatalog::Reader>(shared));
+    }
+    try {
+        SharedCatalog::Reader extra(shared);
+        cout << "  FAILED: reader " << SharedCatalog::MAX_READERS + 1 << " was given a slot" << endl;
+        ++failures;
+    }
+    catch (const runtime_error&) {
+    }
+    return failures;
+}
+
+/**
+ * @brief Describes a graph by course ID, so graphs that number their 
+ * courses differently can be compared.
+ *
+ * @param graph The graph to describe.
+ * @return One line per course with its sorted prerequisites and 
+ *         dependents, then one line per missing course with its sorted 
+ *         dependents.
+ */
+vector<string> describeGraph(const PrerequisiteGraph& graph) {
+    auto names = [&graph](const uint32_t* first, const uint32_t* last) {
+        vector<string_view> courseIds;
+        for (; first != last; ++first) {
+            courseIds.push_back(graph.CourseId(*first));
         }
+        sort(courseIds.begin(), courseIds.end());
 
-        // Stream failed before EOF (e.g., corrupted input)
-        if (!inCourseFS.eof() && inCourseFS.fail()) {
-            throw runtime_error("Data input failure before reaching the end of file.");
+        string joined;
+        for (string_view courseId : courseIds) {
+            joined.append(" ").append(courseId);
         }
+        return joined;
+    };
 
-        inCourseFS.close();
+    vector<string> lines;
+    for (uint32_t id = 0; id < graph.IdBound(); ++id) {
+        if (graph.Contains(id)) {
+            PrerequisiteGraph::EdgeList prerequisites = graph.Prerequisites(id);
+            PrerequisiteGraph::EdgeList dependents = graph.Dependents(id);
+            lines.push_back(string(graph.CourseId(id)) + " <-" + names(prerequisites.begin(), prerequisites.end()) +
+                            " ->" + names(dependents.begin(), dependents.end()));
+        }
+    }
+    graph.VisitUnresolved([&](string_view courseId, const vector<uint32_t>& dependents) {
+        lines.push_back("missing " + string(courseId) + " ->" + names(dependents.data(), dependents.data() + dependents.size()));
+    });
+    sort(lines.begin(), lines.end());
+    return lines;
+}
 
-        // Display non-fatal error summary
-        if (errorCount > 0) {
-            cout << "Warning: " << errorCount << " line(s) contained invalid course data and were skipped." << endl;
+/**
+ * @brief Checks incremental PrerequisiteGraph edits against fresh rebuilds.
+ *
+ * Applies random inserts and removes to a tree and a graph side by side. 
+ * The inserted courses include prerequisites that name missing courses 
+ * and courses that list themselves. Every CHECK_GRAPH_INTERVAL edits, and 
+ * after the last one, the graph is compared by course ID with 
+ * PrerequisiteGraph(tree): the same courses, prerequisites, dependents and 
+ * missing prerequisites, and the same counts. The course pool is small 
+ * enough that removals leave the edge arrays to be compacted many times.
+ *
+ * @param edits Number of random edits.
+ * @return Number of comparisons that failed.
+ */
+size_t checkPrerequisiteGraph(size_t edits) {
+    constexpr size_t CHECK_GRAPH_POOL = 3000;
+    constexpr size_t CHECK_GRAPH_INTERVAL = 5000;
+
+    mt19937 rng(950);
+    auto courseId = [](size_t i) { return "CHK" + to_string(i); };
+
+    BinarySearchTree tree;
+    PrerequisiteGraph graph(tree);
+    size_t comparisons = 0;
+    size_t failures = 0;
+
+    for (size_t edit = 1; edit <= edits; ++edit) {
+        string target = courseId(rng() % CHECK_GRAPH_POOL);
+
+        if (const Course* existing = tree.Find(target)) {
+            graph.Remove(*existing);
+            tree.Remove(target);
+        }
+        else {
+            Course course;
+            course.courseId = target;
+            course.name = "Check Course";
+            for (size_t p = rng() % 4; p > 0; --p) {
+                course.prerequisites.emplace_back(courseId(rng() % CHECK_GRAPH_POOL));
+            }
+            if (rng() % 10 == 0) {
+                course.prerequisites.emplace_back(target);
+            }
+            graph.Insert(course);
+            tree.Insert(course);
         }
 
-        // Display number of duplicate courses ignored
-        if (duplicateCount > 0)
-            cout << "Ignored " << duplicateCount << " duplicate course(s)." << endl;
+        if (edit % CHECK_GRAPH_INTERVAL == 0 || edit == edits) {
+            PrerequisiteGraph fresh(tree);
+            ++comparisons;
 
-    } catch (const exception& ex) {
-        cerr << "Fatal error while loading courses: " << ex.what() << endl;
-        return -1;
+            if (graph.Size() != tree.Size() || graph.EdgeCount() != fresh.EdgeCount() ||
+                graph.UnresolvedCount() != fresh.UnresolvedCount() || describeGraph(graph) != describeGraph(fresh)) {
+                cout << "  FAILED: graph differs from a rebuild after " << edit << " edits" << endl;
+                ++failures;
+            }
+        }
     }
 
-    return errorCount;
+    cout << "  " << edits << " edits, " << comparisons << " comparisons with a rebuild, "
+         << failures << " mismatched (" << graph.Size() << " courses, " << graph.EdgeCount() << " edges left)" << endl;
+    return failures;
+}
+
+/**
+ * @brief Runs the self checks and reports whether they all passed.
+ *
+ * @return 0 if every check passed, 1 otherwise.
+ */
+int runSelfChecks() {
+    size_t failures = 0;
+
+    cout << "Shared catalog check:" << endl;
+    failures += checkSharedCatalog(200);
+
+    cout << "Prerequisite graph check:" << endl;
+    failures += checkPrerequisiteGraph(60000);
+
+    if (failures > 0) {
+        cout << failures << " check(s) failed." << endl;
+        return 1;
+    }
+    cout << "All checks passed." << endl;
+    return 0;
 }
 
 //============================================================================
@@ -586,7 +8272,189 @@ int loadCourses(string filePath, unique_ptr<BinarySearchTree>& courseList) {
 int main(int argc, char* argv[]) {
 
     // Initialize Variables
-    string filePath, courseId;
+    string filePath, courseId, rangeEnd;
+    size_t page = 0;
+
+    // Benchmark mode: --benchmark [rows]
+    if (argc >= 2 && string(argv[1]) == "--benchmark") {
+        return runBenchmarks(argc >= 3 ? stoul(argv[2]) : 1000000);
+    }
+
+    // Self check mode: --selfcheck
+    if (argc >= 2 && string(argv[1]) == "--selfcheck") {
+        return runSelfChecks();
+    }
+
+    // Scan modes: --range <first> <last> [file] and --prefix <prefix> [file]
+    if (argc >= 2 && (string(argv[1]) == "--range" || string(argv[1]) == "--prefix")) {
+        bool range = string(argv[1]) == "--range";
+        int fileArg = range ? 4 : 3;
+
+        if (argc < fileArg) {
+            cout << "Usage: " << argv[0] << (range ? " --range <first> <last> [file]" : " --prefix <prefix> [file]") << endl;
+            return 1;
+        }
+
+        unique_ptr<BinarySearchTree> courseList = make_unique<BinarySearchTree>();
+        filePath = argc > fileArg ? argv[fileArg] : "ABCU_Advising_Program_Input_Extended.csv";
+        if (loadCourses(filePath, courseList) < 0 || replayCatalogLog(filePath, courseList) < 0) {
+            return 1;
+        }
+        validateCatalog(PrerequisiteGraph(*courseList));
+
+        string first = argv[2];
+        string last = range ? argv[3] : "";
+        transform(first.begin(), first.end(), first.begin(), ::toupper);
+        transform(last.begin(), last.end(), last.begin(), ::toupper);
+
+        cout << endl;
+        displayCourseScan(*courseList, first, last);
+        return 0;
+    }
+
+    // Binary catalog modes: --convert <csv> <bin> and --mapped <bin> [courseId | --range <first> <last> | --prefix <prefix>]
+    if (argc >= 2 && string(argv[1]) == "--convert") {
+        if (argc < 4) {
+            cout << "Usage: " << argv[0] << " --convert <csv file> <binary file>" << endl;
+            return 1;
+        }
+
+        unique_ptr<BinarySearchTree> courseList = make_unique<BinarySearchTree>();
+        if (loadCourses(argv[2], courseList) < 0 || replayCatalogLog(argv[2], courseList) < 0) {
+            return 1;
+        }
+        validateCatalog(PrerequisiteGraph(*courseList));
+
+        try {
+            MappedCatalog::Write(argv[3], *courseList);
+        }
+        catch (const exception& ex) {
+            cerr << "Fatal error while writing catalog: " << ex.what() << endl;
+            return 1;
+        }
+        cout << "Wrote " << courseList->Size() << " course(s) to " << argv[3] << endl;
+        return 0;
+    }
+
+    if (argc >= 2 && string(argv[1]) == "--mapped") {
+        if (argc < 3) {
+            cout << "Usage: " << argv[0] << " --mapped <binary file> [courseId | --range <first> <last> | --prefix <prefix>]" << endl;
+            return 1;
+        }
+
+        try {
+            MappedCatalog catalog(argv[2]);
+            vector<string> query(argv + 3, argv + argc);
+            for (string& argument : query) {
+                if (argument.rfind("--", 0) != 0) {
+                    transform(argument.begin(), argument.end(), argument.begin(), ::toupper);
+                }
+            }
+
+            if (query.empty()) {
+                catalog.VisitInOrder([](const MappedCatalog::CourseView& course) {
+                    cout << course.courseId << ", " << course.name << endl;
+                });
+            }
+            else if (query[0] == "--range" && query.size() >= 3) {
+                displayCourseScan(catalog, query[1], query[2]);
+            }
+            else if (query[0] == "--prefix" && query.size() >= 2) {
+                displayCourseScan(catalog, query[1], "");
+            }
+            else if (optional<MappedCatalog::CourseView> found = catalog.Find(query[0])) {
+                displayCourse(*found);
+            }
+            else {
+                cout << "Course ID " << query[0] << " not found." << endl;
+            }
+        }
+        catch (const exception& ex) {
+            cerr << "Fatal error while reading catalog: " << ex.what() << endl;
+            return 1;
+        }
+        return 0;
+    }
+
+    // Compaction mode: --compact [file]
+    if (argc >= 2 && string(argv[1]) == "--compact") {
+        unique_ptr<BinarySearchTree> courseList = make_unique<BinarySearchTree>();
+        unique_ptr<CatalogLog> log;
+        filePath = argc >= 3 ? argv[2] : "ABCU_Advising_Program_Input_Extended.csv";
+        if (filePath == "-") {
+            cout << "Standard input has no edit log to compact." << endl;
+            return 1;
+        }
+
+        if (loadCourses(filePath, courseList) < 0 || openCatalogLog(filePath, courseList, log) < 0) {
+            return 1;
+        }
+        validateCatalog(PrerequisiteGraph(*courseList));
+
+        try {
+            log->Compact(*courseList, filePath);
+        }
+        catch (const exception& ex) {
+            cerr << "Fatal error while compacting: " << ex.what() << endl;
+            return 1;
+        }
+        cout << "Wrote " << courseList->Size() << " course(s) to " << filePath << " and emptied its edit log." << endl;
+        return 0;
+    }
+
+    // Closure mode: --closure <courseId> [file]
+    if (argc >= 2 && string(argv[1]) == "--closure") {
+        if (argc < 3) {
+            cout << "Usage: " << argv[0] << " --closure <courseId> [file]" << endl;
+            return 1;
+        }
+
+        unique_ptr<BinarySearchTree> courseList = make_unique<BinarySearchTree>();
+        filePath = argc >= 4 ? argv[3] : "ABCU_Advising_Program_Input_Extended.csv";
+        if (loadCourses(filePath, courseList) < 0 || replayCatalogLog(filePath, courseList) < 0) {
+            return 1;
+        }
+        PrerequisiteGraph graph(*courseList);
+        validateCatalog(graph);
+
+        courseId = argv[2];
+        transform(courseId.begin(), courseId.end(), courseId.begin(), ::toupper);
+
+        const Course* found = courseList->Find(courseId);
+        if (!found) {
+            cout << "Course ID " << courseId << " not found." << endl;
+            return 1;
+        }
+
+        PrerequisiteClosure closure(graph);
+        displayCourse(*found);
+        displayAllPrerequisites(closure, graph, *found);
+        return 0;
+    }
+
+    // Impact mode: --impact <courseId> [file]
+    if (argc >= 2 && string(argv[1]) == "--impact") {
+        if (argc < 3) {
+            cout << "Usage: " << argv[0] << " --impact <courseId> [file]" << endl;
+            return 1;
+        }
+
+        unique_ptr<BinarySearchTree> courseList = make_unique<BinarySearchTree>();
+        filePath = argc >= 4 ? argv[3] : "ABCU_Advising_Program_Input_Extended.csv";
+        if (loadCourses(filePath, courseList) < 0 || replayCatalogLog(filePath, courseList) < 0) {
+            return 1;
+        }
+        PrerequisiteGraph graph(*courseList);
+        validateCatalog(graph);
+
+        courseId = argv[2];
+        transform(courseId.begin(), courseId.end(), courseId.begin(), ::toupper);
+
+        PrerequisiteClosure closure(graph);
+        cout << courseId << (courseList->Contains(courseId) ? "" : " (not in the catalog)") << endl;
+        displayImpact(closure, graph, courseId);
+        return 0;
+    }
 
     // Process command line arguments
     switch (argc) {
@@ -604,7 +8472,10 @@ int main(int argc, char* argv[]) {
 
     // Define a binary search tree to hold all courses
     unique_ptr<BinarySearchTree> courseList = make_unique<BinarySearchTree>();
-    Course course;
+    unique_ptr<CatalogLog> log;     // Opened with the catalog; records edits
+    PrerequisiteGraph graph;        // Kept in step with courseList for closure queries
+    PrerequisiteClosure closure(graph);
+    const Course* course = nullptr;
 
     cout << "Welcome to the course planner." << endl;
 
@@ -614,6 +8485,11 @@ int main(int argc, char* argv[]) {
         cout << "  1. Load Courses" << endl;
         cout << "  2. Display All Courses" << endl;
         cout << "  3. Find Course" << endl;
+        cout << "  4. List Courses in a Range" << endl;
+        cout << "  5. List Courses by Prefix" << endl;
+        cout << "  6. Display Courses by Page" << endl;
+        cout << "  7. Add a Course" << endl;
+        cout << "  8. Remove a Course" << endl;
         cout << "  9. Exit" << endl;
         cout << endl;
         cout << "What would you like to do? ";
@@ -624,8 +8500,13 @@ int main(int argc, char* argv[]) {
         case 1:
             cout << endl; // Empty line for readability
 
-            // Complete the method call to load the courses
-            loadCourses(filePath, courseList);
+            // Reloading replaces the current catalog
+            courseList->Clear();
+            if (loadCourses(filePath, courseList) >= 0) {
+                openCatalogLog(filePath, courseList, log);
+            }
+            graph.Rebuild(*courseList);
+            validateCatalog(graph);
 
             break;
 
@@ -649,11 +8530,12 @@ int main(int argc, char* argv[]) {
 
             cout << endl; // Empty line for readability
 
-            course = courseList->Search(courseId);
+            course = courseList->Find(courseId);
 
             // If course is found
-            if (!course.courseId.empty()) {
-                displayCourse(course);// Print Course Information
+            if (course) {
+                displayCourse(*course);// Print Course Information
+                displayAllPrerequisites(closure, graph, *course);
             }
             //Else
             else {
@@ -662,6 +8544,134 @@ int main(int argc, char* argv[]) {
 
             break;
 
+        case 4:
+            cout << endl; // Empty line for readability
+            cout << "Enter the first and last course IDs (e.g. MATH200 MATH299): ";
+            cin >> courseId >> rangeEnd;
+
+            transform(courseId.begin(), courseId.end(), courseId.begin(), ::toupper);
+            transform(rangeEnd.begin(), rangeEnd.end(), rangeEnd.begin(), ::toupper);
+
+            cout << endl; // Empty line for readability
+
+            displayCourseScan(*courseList, courseId, rangeEnd);
+
+            break;
+
+        case 5:
+            cout << endl; // Empty line for readability
+            cout << "Enter the start of the course ID (e.g. CSCI3): ";
+            cin >> courseId;
+
+            transform(courseId.begin(), courseId.end(), courseId.begin(), ::toupper);
+
+            cout << endl; // Empty line for readability
+
+            displayCourseScan(*courseList, courseId, "");
+
+            break;
+
+        case 6:
+            cout << endl; // Empty line for readability
+            cout << "Which page do you want to see? ";
+
+            if (!(cin >> page)) {
+                cout << "That entry is not a valid page number." << endl;
+                cin.clear(); // Clear cin error flag
+                cin.ignore(numeric_limits<streamsize>::max(), '\n');// Ignore Additional Input
+                break;
+            }
+
+            cout << endl; // Empty line for readability
+
+            displayCoursePage(*courseList, page);
+
+            break;
+
+        case 7:
+            cout << endl; // Empty line for readability
+            if (!log) {
+                cout << "Load the courses from a file before editing them." << endl;
+                break;
+            }
+            cout << "Enter the course as <courseId>,<courseName>,<prerequisite>,...: ";
+            cin.ignore();
+
+            {
+                string line;
+                getline(cin, line);
+                vector<string_view> fields;
+                splitLine(line, ',', fields);
+                vector<string> courseInfo(fields.begin(), fields.end());
+
+                // IDs are stored in upper case; the name is kept as typed
+                for (size_t i = 0; i < courseInfo.size(); ++i) {
+                    if (i != 1) {
+                        transform(courseInfo[i].begin(), courseInfo[i].end(), courseInfo[i].begin(), ::toupper);
+                    }
+                }
+
+                if (courseInfo.size() < 2) {
+                    cout << "That entry is not a valid course." << endl;
+                    break;
+                }
+
+                Course added;
+                added.courseId = courseInfo[0];
+                added.name = courseInfo[1];
+                for (size_t i = 2; i < courseInfo.size(); ++i) {
+                    added.prerequisites.emplace_back(courseInfo[i]);
+                }
+
+                try {
+                    courseList->Insert(added);
+                    graph.Insert(added);
+                    log->Commit(log->AppendInsert(added));
+                    cout << "Added " << added.courseId << "." << endl;
+                }
+                catch (const BinarySearchTree::DuplicateCourseException& ex) {
+                    cout << "Warning: " << ex.what() << endl;
+                }
+                catch (const exception& ex) {
+                    cerr << "Error: the edit was applied but could not be saved: " << ex.what() << endl;
+                }
+            }
+
+            break;
+
+        case 8:
+            cout << endl; // Empty line for readability
+            if (!log) {
+                cout << "Load the courses from a file before editing them." << endl;
+                break;
+            }
+            cout << "Which course do you want to remove? ";
+            cin >> courseId;
+
+            transform(courseId.begin(), courseId.end(), courseId.begin(), ::toupper);
+
+            if (!courseList->Contains(courseId)) {
+                cout << "Course ID " << courseId << " not found." << endl;
+                break;
+            }
+
+            cout << endl; // Empty line for readability
+
+            // Show what retiring it affects; the dependents keep it as a missing prerequisite
+            displayImpact(closure, graph, courseId);
+
+            graph.Remove(*courseList->Find(courseId));
+            courseList->Remove(courseId);
+            try {
+                log->Commit(log->AppendRemove(courseId));
+                cout << "Removed " << courseId << "." << endl;
+            }
+            catch (const exception& ex) {
+                cerr << "Error: the edit was applied but could not be saved: " << ex.what() << endl;
+            }
+
+            break;
+
         case 9:
             break;
 